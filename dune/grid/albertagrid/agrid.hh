@@ -27,6 +27,7 @@
 #include <dune/grid/common/gridfactory.hh>
 #include <dune/grid/common/adaptcallback.hh>
 #include <dune/grid/common/sizecache.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 
 //- Local includes
 // some cpp defines and include of alberta.h
@@ -453,6 +454,12 @@ namespace Dune
     //! clean up some markers
     void postAdapt();
 
+    //! obtain counters and timers of the adaptation process
+    const AdaptationStatistics &adaptationStatistics () const { return adaptationStatistics_; }
+
+    //! obtain counters and timers of the adaptation process (e.g., to reset them)
+    AdaptationStatistics &adaptationStatistics () { return adaptationStatistics_; }
+
     /** \brief return reference to collective communication, if MPI found
      * this is specialisation for MPI */
     const CollectiveCommunication &comm () const
@@ -564,7 +571,7 @@ namespace Dune
 
     // make the calculation of indexOnLevel and so on.
     // extra method because of Reihenfolge
-    void calcExtras();
+    void calcExtras ( bool updateLeafIndexSet = true );
 
   private:
     // delete mesh and all vectors
@@ -667,6 +674,9 @@ namespace Dune
 
     // current state of adaptation
     AdaptationState adaptationState_;
+
+    // counters and timers of the adaptation process
+    AdaptationStatistics adaptationStatistics_;
   };
 
 } // namespace Dune
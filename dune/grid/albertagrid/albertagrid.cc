@@ -305,6 +305,7 @@ namespace Dune
 
     // only MAXL levels allowed
     assert( (refCount >= 0) && (refCount + maxlevel_ < MAXL) );
+    AdaptationStatistics::Timer timer( adaptationStatistics_.globalRefineTime );
 
     for( int i = 0; i < refCount; ++i )
     {
@@ -329,6 +330,7 @@ namespace Dune
 
     // only MAXL levels allowed
     assert( (refCount >= 0) && (refCount + maxlevel_ < MAXL) );
+    AdaptationStatistics::Timer timer( adaptationStatistics_.globalRefineTime );
 
     for( int i = 0; i < refCount; ++i )
     {
@@ -345,6 +347,7 @@ namespace Dune
   template< int dim, int dimworld >
   inline bool AlbertaGrid< dim, dimworld >::preAdapt ()
   {
+    AdaptationStatistics::Timer timer( adaptationStatistics_.preAdaptTime );
     adaptationState_.preAdapt();
     return adaptationState_.coarsen();
   }
@@ -353,6 +356,8 @@ namespace Dune
   template < int dim, int dimworld >
   inline void AlbertaGrid < dim, dimworld >::postAdapt ()
   {
+    AdaptationStatistics::Timer timer( adaptationStatistics_.postAdaptTime );
+
 #ifndef NDEBUG
     if( leafIndexSet_ != 0 )
     {
@@ -395,6 +400,10 @@ namespace Dune
 
     // set new marking
     adaptationState_.mark( refCount );
+    if( refCount > 0 )
+      AdaptationStatistics::count( adaptationStatistics_.markedForRefinement );
+    else if( refCount < 0 )
+      AdaptationStatistics::count( adaptationStatistics_.markedForCoarsening );
     getRealImplementation( e ).elementInfo().setMark( refCount );
 
     return true;
@@ -415,6 +424,24 @@ namespace Dune
     // this is already done in postAdapt
     //levelProvider_.markAllOld();
 
+    AdaptationStatistics::Timer timer( adaptationStatistics_.adaptTime );
+    AdaptationStatistics::count( adaptationStatistics_.adaptCalls );
+    const long oldElements = mesh_.size( 0 );
+
+    // update an existing leaf index set on the fly
+    typedef AdaptationCallback< typename GridFamily::LeafIndexSetImp > LeafIndexSetCallback;
+    typename LeafIndexSetCallback::DofVectorPointer leafIndexSetCallbackVector;
+    const bool updateLeafIndexSet
+      = (leafIndexSet_ != 0) && LeafIndexSetCallback::DofVectorPointer::supportsAdaptationData;
+    if( updateLeafIndexSet )
+    {
+      leafIndexSet_->preAdapt();
+      leafIndexSetCallbackVector.create( dofNumbering_.emptyDofSpace(), "Leaf Index Set Callback" );
+      leafIndexSetCallbackVector.template setupInterpolation< LeafIndexSetCallback >();
+      leafIndexSetCallbackVector.template setupRestriction< LeafIndexSetCallback >();
+      leafIndexSetCallbackVector.setAdaptationData( leafIndexSet_ );
+    }
+
     // adapt mesh
     hIndexSet_.preAdapt();
     const bool refined = mesh_.refine();
@@ -422,8 +449,16 @@ namespace Dune
     adaptationState_.adapt();
     hIndexSet_.postAdapt();
 
+    if( updateLeafIndexSet )
+    {
+      leafIndexSetCallbackVector.release();
+      AdaptationStatistics::Timer indexSetTimer( adaptationStatistics_.indexSetTime );
+      leafIndexSet_->postAdapt();
+    }
+
     if( refined || coarsened )
-      calcExtras();
+      calcExtras( !updateLeafIndexSet );
+    adaptationStatistics_.changeElements( oldElements, mesh_.size( 0 ) );
 
     // return true if elements were created
     return refined;
@@ -440,7 +475,10 @@ namespace Dune
 
     preAdapt();
     const int refineMarked = adaptationState_.refineMarked();
-    handle.preAdapt( std::max( defaultElementChunk, 4*refineMarked ) );
+    {
+      AdaptationStatistics::Timer callbackTimer( adaptationStatistics_.callbackTime );
+      handle.preAdapt( std::max( defaultElementChunk, 4*refineMarked ) );
+    }
 
     typedef Alberta::AdaptRestrictProlongHandler
     < This, AdaptDataHandleInterface< This, DataHandle > >
@@ -463,7 +501,10 @@ namespace Dune
       Alberta::adaptationDataHandler_ = 0;
     callbackVector.release();
 
-    handle.postAdapt();
+    {
+      AdaptationStatistics::Timer callbackTimer( adaptationStatistics_.callbackTime );
+      handle.postAdapt();
+    }
     postAdapt();
     return refined;
   }
@@ -528,7 +569,7 @@ namespace Dune
 
     if( levelIndexVec_[ level ] == 0 )
     {
-      levelIndexVec_[ level ] = new typename GridFamily::LevelIndexSetImp ( dofNumbering_ );
+      levelIndexVec_[ level ] = new typename GridFamily::LevelIndexSetImp ( hIndexSet_ );
       levelIndexVec_[ level ]->update( lbegin< 0 >( level ), lend< 0 >( level ) );
     }
     return *(levelIndexVec_[ level ]);
@@ -540,7 +581,7 @@ namespace Dune
   {
     if( leafIndexSet_ == 0 )
     {
-      leafIndexSet_ = new typename GridFamily::LeafIndexSetImp( dofNumbering_ );
+      leafIndexSet_ = new typename GridFamily::LeafIndexSetImp( hIndexSet_ );
       leafIndexSet_->update( leafbegin< 0 >(), leafend< 0 >() );
     }
     return *leafIndexSet_;
@@ -548,7 +589,7 @@ namespace Dune
 
 
   template < int dim, int dimworld >
-  inline void AlbertaGrid < dim, dimworld >::calcExtras ()
+  inline void AlbertaGrid < dim, dimworld >::calcExtras ( bool updateLeafIndexSet )
   {
     // determine new maxlevel
     maxlevel_ = levelProvider_.maxLevel();
@@ -564,7 +605,8 @@ namespace Dune
     sizeCache_.reset();
 
     // update index sets (if they exist)
-    if( leafIndexSet_ != 0 )
+    AdaptationStatistics::Timer timer( adaptationStatistics_.indexSetTime );
+    if( (leafIndexSet_ != 0) && updateLeafIndexSet )
       leafIndexSet_->update( leafbegin< 0 >(), leafend< 0 >() );
     for( unsigned int level = 0; level < levelIndexVec_.size(); ++level )
     {
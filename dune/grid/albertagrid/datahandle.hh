@@ -6,6 +6,7 @@
 #include <iostream>
 
 #include <dune/grid/common/grid.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 
 #include <dune/grid/albertagrid/misc.hh>
 #include <dune/grid/albertagrid/albertaheader.hh>
@@ -45,6 +46,10 @@ namespace Dune
 
       void restrictLocal ( const Patch &patch, int i )
       {
+        AdaptationStatistics &statistics = grid_.adaptationStatistics();
+        AdaptationStatistics::count( statistics.coarsened );
+        AdaptationStatistics::Timer timer( statistics.callbackTime );
+
         ElementInfo fatherInfo = patch.elementInfo( i, grid_.levelProvider() );
         Grid::getRealImplementation( father_ ).setElement( fatherInfo, 0 );
         rpOp_.preCoarsening( (const Entity &)father_ );
@@ -52,6 +57,10 @@ namespace Dune
 
       void prolongLocal ( const Patch &patch, int i )
       {
+        AdaptationStatistics &statistics = grid_.adaptationStatistics();
+        AdaptationStatistics::count( statistics.refined );
+        AdaptationStatistics::Timer timer( statistics.callbackTime );
+
         ElementInfo fatherInfo = patch.elementInfo( i, grid_.levelProvider() );
         Grid::getRealImplementation( father_ ).setElement( fatherInfo, 0 );
         rpOp_.postRefinement( (const Entity &)father_ );
@@ -40,6 +40,9 @@ namespace Dune
     {
       struct Instance;
       class Stack;
+#ifdef _OPENMP
+      struct StackRegistry;
+#endif
 
       template< int >
       struct Library;
@@ -200,23 +203,61 @@ namespace Dune
     // ElementInfo::Stack
     // ------------------
 
+    /* Free list of instances
+     *
+     * Instances are allocated in blocks of blockSize and are never returned
+     * to the heap before the stack is destroyed. Hence, after the first
+     * traversal, no further memory allocation takes place.
+     *
+     * If OpenMP is enabled, each thread uses its own stack (see
+     * ElementInfo::stack()). An instance may be released on a different
+     * thread than it was allocated on; it then simply moves to the other
+     * thread's free list. Therefore, the blocks may only be released when all
+     * stacks are destroyed, i.e., on program exit.
+     */
     template< int dim >
     class ElementInfo< dim >::Stack
     {
+      static const int blockSize = 64;
+
       InstancePtr top_;
-      Instance null_;
+      std::vector< InstancePtr > blocks_;
 
     public:
       Stack ();
+      // copying creates a new, empty stack
+      Stack ( const Stack &other );
       ~Stack ();
 
       InstancePtr allocate ();
       void release ( InstancePtr &p );
-      InstancePtr null ();
+
+    private:
+      Stack &operator= ( const Stack & );
     };
 
 
 
+#ifdef _OPENMP
+    // ElementInfo::StackRegistry
+    // --------------------------
+
+    // owner of the per-thread stacks
+    template< int dim >
+    struct ElementInfo< dim >::StackRegistry
+    {
+      ~StackRegistry ()
+      {
+        for( typename std::vector< Stack * >::iterator it = stacks.begin(); it != stacks.end(); ++it )
+          delete *it;
+      }
+
+      std::vector< Stack * > stacks;
+    };
+#endif // #ifdef _OPENMP
+
+
+
     // ElementInfo::Library
     // --------------------
 
@@ -316,7 +357,6 @@ namespace Dune
     {
       instance_ = stack().allocate();
       instance_->parent() = null();
-      ++(instance_->parent()->refCount);
 
       addReference();
 
@@ -337,7 +377,6 @@ namespace Dune
     {
       instance_ = stack().allocate();
       instance_->parent() = null();
-      ++(instance_->parent()->refCount);
 
       addReference();
 
@@ -814,7 +853,6 @@ namespace Dune
     {
       InstancePtr instance = stack().allocate();
       instance->parent() = null();
-      ++(instance->parent()->refCount);
 
       instance->elInfo.mesh = mesh;
       instance->elInfo.macro_el = NULL;
@@ -834,7 +872,6 @@ namespace Dune
     {
       InstancePtr instance = stack().allocate();
       instance->parent() = null();
-      ++(instance->parent()->refCount);
 
       instance->elInfo = elInfo;
       return ElementInfo< dim >( instance );
@@ -905,7 +942,9 @@ namespace Dune
     template< int dim >
     inline void ElementInfo< dim >::addReference () const
     {
-      ++(instance_->refCount);
+      // the null instance is shared by all threads, so it is not reference counted
+      if( instance_ != null() )
+        ++(instance_->refCount);
     }
 
 
@@ -913,7 +952,7 @@ namespace Dune
     inline void ElementInfo< dim >::removeReference () const
     {
       // this loop breaks when instance becomes null()
-      for( InstancePtr instance = instance_; --(instance->refCount) == 0; )
+      for( InstancePtr instance = instance_; (instance != null()) && (--(instance->refCount) == 0); )
       {
         const InstancePtr parent = instance->parent();
         stack().release( instance );
@@ -926,7 +965,11 @@ namespace Dune
     inline typename ElementInfo< dim >::InstancePtr
     ElementInfo< dim >::null ()
     {
-      return stack().null();
+      // static storage is zero initialized, i.e., elInfo.el is NULL
+      // Note: The null instance is neither allocated from nor released to a
+      //       stack (see addReference, removeReference and Stack::release).
+      static Instance null_;
+      return &null_;
     }
 
 
@@ -934,8 +977,26 @@ namespace Dune
     inline typename ElementInfo< dim >::Stack &
     ElementInfo< dim >::stack ()
     {
+#ifdef _OPENMP
+      // Each thread (also within nested parallel regions) creates its own
+      // stack on first use. The stacks are owned by a registry and are only
+      // destroyed on program exit (see ElementInfo::Stack).
+      static Stack *s = 0;
+#pragma omp threadprivate( s )
+      if( !s )
+      {
+        s = new Stack;
+#pragma omp critical( DuneAlbertaElementInfoStack )
+        {
+          static StackRegistry registry;
+          registry.stacks.push_back( s );
+        }
+      }
+      return *s;
+#else
       static Stack s;
       return s;
+#endif
     }
 
 
@@ -946,22 +1007,20 @@ namespace Dune
     template< int dim >
     inline ElementInfo< dim >::Stack::Stack ()
       : top_( 0 )
-    {
-      null_.elInfo.el = NULL;
-      null_.refCount = 1;
-      null_.parent() = 0;
-    }
+    {}
+
+
+    template< int dim >
+    inline ElementInfo< dim >::Stack::Stack ( const Stack & )
+      : top_( 0 )
+    {}
 
 
     template< int dim >
     inline ElementInfo< dim >::Stack::~Stack ()
     {
-      while( top_ != 0 )
-      {
-        InstancePtr p = top_;
-        top_ = p->parent();
-        delete p;
-      }
+      for( typename std::vector< InstancePtr >::iterator it = blocks_.begin(); it != blocks_.end(); ++it )
+        delete[] *it;
     }
 
 
@@ -969,11 +1028,19 @@ namespace Dune
     inline typename ElementInfo< dim >::InstancePtr
     ElementInfo< dim >::Stack::allocate ()
     {
+      if( top_ == 0 )
+      {
+        InstancePtr block = new Instance[ blockSize ];
+        blocks_.push_back( block );
+        for( int i = 0; i < blockSize; ++i )
+        {
+          block[ i ].parent() = top_;
+          top_ = block + i;
+        }
+      }
+
       InstancePtr p = top_;
-      if( p != 0 )
-        top_ = p->parent();
-      else
-        p = new Instance;
+      top_ = p->parent();
       p->refCount = 0;
       return p;
     }
@@ -987,14 +1054,6 @@ namespace Dune
       top_ = p;
     }
 
-
-    template< int dim >
-    inline typename ElementInfo< dim >::InstancePtr
-    ElementInfo< dim >::Stack::null ()
-    {
-      return &null_;
-    }
-
   } // namespace Alberta
 
 } // namespace Dune
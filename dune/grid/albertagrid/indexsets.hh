@@ -3,6 +3,10 @@
 #ifndef DUNE_ALBERTAGRIDINDEXSETS_HH
 #define DUNE_ALBERTAGRIDINDEXSETS_HH
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <dune/common/stdstreams.hh>
 
 #include <dune/grid/common/grid.hh>
@@ -316,6 +320,26 @@ namespace Dune
   // AlbertaGridIndexSet
   // -------------------
 
+  /** \brief level or leaf index set of AlbertaGrid
+   *
+   *  The consecutive indices are stored in vectors indexed by the
+   *  hierarchic index of the entity. Unlike ALBERTA's DOF numbers, hierarchic
+   *  indices are not changed by DOF compression, so that the index set can be
+   *  updated incrementally during adaptation (see preAdapt()).
+   *
+   *  For each entity of codimension > 0, the number of elements of the set
+   *  containing it is counted. An entity is removed from the set as soon as
+   *  this number drops to zero.
+   *
+   *  The compaction map of the leaf index set can be used to migrate user
+   *  data after adaptation. It is obtained by casting the leaf index set to
+   *  its implementation:
+   *  \code
+   *  typedef typename Grid::GridFamily::LeafIndexSetImp LeafIndexSetImp;
+   *  const LeafIndexSetImp &indexSet
+   *    = static_cast< const LeafIndexSetImp & >( grid.leafIndexSet() );
+   *  \endcode
+   */
   template< int dim, int dimworld >
   class AlbertaGridIndexSet
     : public IndexSet< AlbertaGrid< dim, dimworld >, AlbertaGridIndexSet< dim, dimworld >, int >
@@ -331,7 +355,14 @@ namespace Dune
     static const int dimension = Grid::dimension;
 
     typedef Alberta::ElementInfo< dimension > ElementInfo;
-    typedef Alberta::HierarchyDofNumbering< dimension > DofNumbering;
+    typedef AlbertaGridHierarchicIndexSet< dim, dimworld > HierarchicIndexSet;
+    typedef Alberta::Patch< dimension > Patch;
+
+    /** \brief map of the indices moved by an incremental update
+     *
+     *  Each entry holds the old and the new index of an entity.
+     */
+    typedef std::vector< std::pair< IndexType, IndexType > > CompactionMap;
 
   private:
     typedef typename Grid::Traits Traits;
@@ -339,25 +370,24 @@ namespace Dune
     template< int codim >
     struct Insert;
 
+    template< int codim >
+    struct Remove;
+
+    template< int codim >
+    struct DeferRemove;
+
   public:
-    explicit AlbertaGridIndexSet ( const DofNumbering &dofNumbering )
-      : dofNumbering_( dofNumbering )
+    explicit AlbertaGridIndexSet ( const HierarchicIndexSet &hIndexSet )
+      : hIndexSet_( hIndexSet ),
+        incremental_( false )
     {
       for( int codim = 0; codim <= dimension; ++codim )
       {
-        indices_[ codim ] = 0;
-
         const GeometryType type( GeometryType::simplex, dimension - codim );
         geomTypes_[ codim ].push_back( type );
       }
     }
 
-    ~AlbertaGridIndexSet ()
-    {
-      for( int codim = 0; codim <= dimension; ++codim )
-        delete[] indices_[ codim ];
-    }
-
     template< class Entity >
     bool contains ( const Entity &entity ) const
     {
@@ -367,10 +397,7 @@ namespace Dune
         = Grid::getRealImplementation( entity );
       const Alberta::Element *element = entityImp.elementInfo().el();
 
-      const IndexType *const array = indices_[ codim ];
-      const IndexType subIndex = array[ dofNumbering_( element, codim, entityImp.subEntity() ) ];
-
-      return (subIndex >= 0);
+      return containsEntity( hIndexSet_.subIndex( element, entityImp.subEntity(), codim ), codim );
     }
 
     using Base::index;
@@ -412,7 +439,7 @@ namespace Dune
     IndexType size ( int codim ) const
     {
       assert( (codim >= 0) && (codim <= dimension) );
-      return size_[ codim ];
+      return entities_[ codim ].size();
     }
 
     const std::vector< GeometryType > &geomTypes( int codim ) const
@@ -426,25 +453,88 @@ namespace Dune
     {
       for( int codim = 0; codim <= dimension; ++codim )
       {
-        delete[] indices_[ codim ];
-
-        const unsigned int dofSize = dofNumbering_.size( codim );
-        indices_[ codim ] = new IndexType[ dofSize ];
-        for( unsigned int i = 0; i < dofSize; ++i )
-          indices_[ codim ][ i ] = -1;
-
-        size_[ codim ] = 0;
+        const unsigned int hSize = hIndexSet_.size( codim );
+        indices_[ codim ].assign( hSize, -1 );
+        counts_[ codim ].assign( hSize, 0 );
+        entities_[ codim ].clear();
+        holes_[ codim ].clear();
+        inserted_[ codim ].clear();
+        removed_[ codim ].clear();
+        compactionMap_[ codim ].clear();
       }
+      refined_.clear();
+      incremental_ = false;
 
       for( Iterator it = begin; it != end; ++it )
       {
         const AlbertaGridEntity< 0, dim, const Grid > &entityImp
           = Grid::getRealImplementation( *it );
-        const Alberta::Element *element = entityImp.elementInfo().el();
-        ForLoop< Insert, 0, dimension >::apply( element, *this );
+        insert( entityImp.elementInfo().el() );
+      }
+    }
+
+    /** \name Incremental Update
+     *
+     *  If the index set is the leaf index set, AlbertaGrid updates it during
+     *  adaptation by calling restrictLocal() and prolongLocal() for each
+     *  coarsened and refined element. Only the entities affected by the
+     *  adaptation are renumbered. To keep the indices consecutive, some
+     *  entities with high indices are moved into the gaps left by removed
+     *  entities; these moves are recorded in the compaction map.
+     *
+     *  Removals are deferred to postAdapt(), so that the indices of all
+     *  entities contained before the adaptation remain valid while the
+     *  callbacks of an AdaptDataHandle run.
+     *  \{
+     */
+
+    /** \brief prepare an incremental update (called by AlbertaGrid) */
+    void preAdapt ()
+    {
+      for( int codim = 0; codim <= dimension; ++codim )
+      {
+        inserted_[ codim ].clear();
+        removed_[ codim ].clear();
+        compactionMap_[ codim ].clear();
       }
+      refined_.clear();
+      incremental_ = true;
+    }
+
+    /** \brief finish an incremental update (called by AlbertaGrid) */
+    void postAdapt ();
+
+    /** \brief called by ALBERTA before the children of patch[ i ] are removed */
+    void restrictLocal ( const Patch &patch, int i );
+
+    /** \brief called by ALBERTA after patch[ i ] has been refined */
+    void prolongLocal ( const Patch &patch, int i )
+    {
+      // the indices of the children might not be set up, yet
+      refined_.push_back( patch[ i ] );
+    }
+
+    /** \brief return true if the last update was incremental */
+    bool incremental () const { return incremental_; }
+
+    /** \brief obtain the indices moved by the last update
+     *
+     *  For each entity contained in the index set before and after the last
+     *  adaptation whose index was changed, the map contains the pair of its
+     *  old and new index. Entities not listed here either keep their index
+     *  or have been created by the last adaptation. The map is only valid if
+     *  incremental() returns true.
+     *
+     *  \param[in]  codim  codimension
+     */
+    const CompactionMap &compactionMap ( int codim ) const
+    {
+      assert( (codim >= 0) && (codim <= dimension) );
+      return compactionMap_[ codim ];
     }
 
+    /** \} */
+
   private:
     IndexType subIndex ( const ElementInfo &elementInfo, int i, unsigned int codim ) const
     {
@@ -460,20 +550,90 @@ namespace Dune
      */
     IndexType subIndex ( const Alberta::Element *element, int i, unsigned int codim ) const
     {
-      const IndexType *const array = indices_[ codim ];
-      const IndexType subIndex = array[ dofNumbering_( element, codim, i ) ];
+      const IndexType hIndex = hIndexSet_.subIndex( element, i, codim );
+      assert( (hIndex >= 0) && (hIndex < (IndexType)indices_[ codim ].size()) );
+      const IndexType subIndex = indices_[ codim ][ hIndex ];
       assert( (subIndex >= 0) && (subIndex < size( codim )) );
       return subIndex;
     }
 
-    // access to the dof vectors
-    const DofNumbering &dofNumbering_;
+    bool containsEntity ( IndexType hIndex, int codim ) const
+    {
+      return (hIndex < (IndexType)indices_[ codim ].size()) && (indices_[ codim ][ hIndex ] >= 0);
+    }
+
+    bool containsElement ( const Alberta::Element *element ) const
+    {
+      return containsEntity( hIndexSet_.subIndex( element, 0, 0 ), 0 );
+    }
+
+    // add an element and its subentities to the set
+    void insert ( const Alberta::Element *element )
+    {
+      ForLoop< Insert, 0, dimension >::apply( element, *this );
+    }
+
+    // remove an element and (if no longer used) its subentities from the set
+    void remove ( const Alberta::Element *element )
+    {
+      ForLoop< Remove, 0, dimension >::apply( element, *this );
+    }
+
+    // remove an element and its subentities in postAdapt()
+    void deferRemove ( const Alberta::Element *element )
+    {
+      ForLoop< DeferRemove, 0, dimension >::apply( element, *this );
+    }
 
-    // an array of indices for each codimension
-    IndexType *indices_[ dimension+1 ];
+    // add all leaf descendants of an element not yet contained in the set
+    void insertLeafDescendants ( const Alberta::Element *element )
+    {
+      if( IS_LEAF_EL( element ) )
+      {
+        if( !containsElement( element ) )
+          insert( element );
+      }
+      else
+      {
+        insertLeafDescendants( element->child[ 0 ] );
+        insertLeafDescendants( element->child[ 1 ] );
+      }
+    }
+
+    void insert ( IndexType hIndex, int codim );
+    void remove ( IndexType hIndex, int codim );
+
+    // fill the gaps left by removed entities
+    void compact ( int codim );
+
+    // the hierarchic index set
+    const HierarchicIndexSet &hIndexSet_;
+
+    // the index of each entity, indexed by the hierarchic index (-1, if not contained)
+    std::vector< IndexType > indices_[ dimension+1 ];
+
+    // the number of elements in the set containing each entity
+    std::vector< int > counts_[ dimension+1 ];
+
+    // the hierarchic index of each entity in the set (-1 for gaps)
+    std::vector< IndexType > entities_[ dimension+1 ];
+
+    // indices freed during an incremental update
+    std::vector< IndexType > holes_[ dimension+1 ];
 
-    // the size of each codimension
-    IndexType size_[ dimension+1 ];
+    // hierarchic indices of the entities inserted during an incremental update
+    std::vector< IndexType > inserted_[ dimension+1 ];
+
+    // hierarchic indices of the entities to be removed in postAdapt()
+    std::vector< IndexType > removed_[ dimension+1 ];
+
+    // indices moved by the last incremental update
+    CompactionMap compactionMap_[ dimension+1 ];
+
+    // elements refined during the current adaptation cycle
+    std::vector< const Alberta::Element * > refined_;
+
+    bool incremental_;
 
     // all geometry types contained in the grid
     std::vector< GeometryType > geomTypes_[ dimension+1 ];
@@ -491,20 +651,183 @@ namespace Dune
     static void apply ( const Alberta::Element *const element,
                         AlbertaGridIndexSet< dim, dimworld > &indexSet )
     {
-      int *const array = indexSet.indices_[ codim ];
-      IndexType &size = indexSet.size_[ codim ];
+      for( int i = 0; i < Alberta::NumSubEntities< dim, codim >::value; ++i )
+        indexSet.insert( indexSet.hIndexSet_.subIndex( element, i, codim ), codim );
+    }
+  };
+
+
+
+  // AlbertaGridIndexSet::Remove
+  // ---------------------------
 
+  template< int dim, int dimworld >
+  template< int codim >
+  struct AlbertaGridIndexSet< dim, dimworld >::Remove
+  {
+    static void apply ( const Alberta::Element *const element,
+                        AlbertaGridIndexSet< dim, dimworld > &indexSet )
+    {
       for( int i = 0; i < Alberta::NumSubEntities< dim, codim >::value; ++i )
-      {
-        int &index = array[ indexSet.dofNumbering_( element, codim, i ) ];
-        if( index < 0 )
-          index = size++;
-      }
+        indexSet.remove( indexSet.hIndexSet_.subIndex( element, i, codim ), codim );
+    }
+  };
+
+
+
+  // AlbertaGridIndexSet::DeferRemove
+  // --------------------------------
+
+  template< int dim, int dimworld >
+  template< int codim >
+  struct AlbertaGridIndexSet< dim, dimworld >::DeferRemove
+  {
+    static void apply ( const Alberta::Element *const element,
+                        AlbertaGridIndexSet< dim, dimworld > &indexSet )
+    {
+      for( int i = 0; i < Alberta::NumSubEntities< dim, codim >::value; ++i )
+        indexSet.removed_[ codim ].push_back( indexSet.hIndexSet_.subIndex( element, i, codim ) );
     }
   };
 
 
 
+  // Implementation of AlbertaGridIndexSet
+  // -------------------------------------
+
+  template< int dim, int dimworld >
+  inline void AlbertaGridIndexSet< dim, dimworld >::postAdapt ()
+  {
+    // Remove the children of coarsened elements. Their hierarchic indices
+    // cannot have been reused, since AlbertaGrid::adapt() refines before it
+    // coarsens.
+    for( int codim = 0; codim <= dimension; ++codim )
+    {
+      typedef typename std::vector< IndexType >::const_iterator Iterator;
+      for( Iterator it = removed_[ codim ].begin(); it != removed_[ codim ].end(); ++it )
+        remove( *it, codim );
+      removed_[ codim ].clear();
+    }
+
+    // Insert the new leaf elements before removing their fathers. This way,
+    // subentities shared by father and children keep their index.
+    typedef typename std::vector< const Alberta::Element * >::const_iterator Iterator;
+    for( Iterator it = refined_.begin(); it != refined_.end(); ++it )
+    {
+      insertLeafDescendants( *it );
+      if( !IS_LEAF_EL( *it ) && containsElement( *it ) )
+        remove( *it );
+    }
+    refined_.clear();
+
+    for( int codim = 0; codim <= dimension; ++codim )
+      compact( codim );
+  }
+
+
+  template< int dim, int dimworld >
+  inline void AlbertaGridIndexSet< dim, dimworld >
+  ::restrictLocal ( const Patch &patch, int i )
+  {
+    // The children are deleted by ALBERTA after this call, so their
+    // hierarchic indices are recorded now. They are removed in postAdapt(),
+    // since user callbacks might still access their indices.
+    const Alberta::Element *father = patch[ i ];
+    if( !containsElement( father ) )
+      insert( father );
+    for( int k = 0; k < 2; ++k )
+    {
+      if( containsElement( father->child[ k ] ) )
+        deferRemove( father->child[ k ] );
+    }
+  }
+
+
+  template< int dim, int dimworld >
+  inline void AlbertaGridIndexSet< dim, dimworld >::insert ( IndexType hIndex, int codim )
+  {
+    assert( hIndex >= 0 );
+    if( hIndex >= (IndexType)indices_[ codim ].size() )
+    {
+      const unsigned int hSize = std::max( hIndexSet_.size( codim ), hIndex+1 );
+      indices_[ codim ].resize( hSize, -1 );
+      counts_[ codim ].resize( hSize, 0 );
+    }
+
+    if( counts_[ codim ][ hIndex ]++ > 0 )
+      return;
+
+    // reuse a gap, if possible
+    IndexType index;
+    if( !holes_[ codim ].empty() )
+    {
+      index = holes_[ codim ].back();
+      holes_[ codim ].pop_back();
+      entities_[ codim ][ index ] = hIndex;
+    }
+    else
+    {
+      index = entities_[ codim ].size();
+      entities_[ codim ].push_back( hIndex );
+    }
+    indices_[ codim ][ hIndex ] = index;
+
+    if( incremental_ )
+      inserted_[ codim ].push_back( hIndex );
+  }
+
+
+  template< int dim, int dimworld >
+  inline void AlbertaGridIndexSet< dim, dimworld >::remove ( IndexType hIndex, int codim )
+  {
+    assert( containsEntity( hIndex, codim ) && (counts_[ codim ][ hIndex ] > 0) );
+    if( --counts_[ codim ][ hIndex ] > 0 )
+      return;
+
+    const IndexType index = indices_[ codim ][ hIndex ];
+    indices_[ codim ][ hIndex ] = -1;
+    entities_[ codim ][ index ] = -1;
+    holes_[ codim ].push_back( index );
+  }
+
+
+  template< int dim, int dimworld >
+  inline void AlbertaGridIndexSet< dim, dimworld >::compact ( int codim )
+  {
+    std::vector< IndexType > &holes = holes_[ codim ];
+    std::vector< IndexType > &entities = entities_[ codim ];
+
+    std::vector< IndexType > &inserted = inserted_[ codim ];
+
+    std::sort( holes.begin(), holes.end() );
+    std::sort( inserted.begin(), inserted.end() );
+    const IndexType newSize = entities.size() - holes.size();
+
+    // move the entities with the highest indices into the gaps below newSize
+    IndexType top = entities.size();
+    typedef typename std::vector< IndexType >::const_iterator Iterator;
+    for( Iterator it = holes.begin(); (it != holes.end()) && (*it < newSize); ++it )
+    {
+      do
+        --top;
+      while( entities[ top ] < 0 );
+
+      const IndexType hIndex = entities[ top ];
+      entities[ *it ] = hIndex;
+      indices_[ codim ][ hIndex ] = *it;
+
+      // entities created by this adaptation carry no data to be moved
+      if( !std::binary_search( inserted.begin(), inserted.end(), hIndex ) )
+        compactionMap_[ codim ].push_back( std::make_pair( top, *it ) );
+    }
+
+    entities.resize( newSize );
+    holes.clear();
+    inserted.clear();
+  }
+
+
+
   // AlbertaGridIdSet
   // ----------------
 
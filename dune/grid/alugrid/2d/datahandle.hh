@@ -7,6 +7,7 @@
 #include <iostream>
 
 #include <dune/grid/common/adaptcallback.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 
 //- local includes
 #include "alu2dinclude.hh"
@@ -64,6 +65,11 @@ namespace ALU2DSPACENAME
     int preCoarsening ( HElementType &father )
     {
       maxlevel_ = std::max( maxlevel_, father.level() );
+
+      Dune::AdaptationStatistics &statistics = grid_.adaptationStatistics();
+      Dune::AdaptationStatistics::count( statistics.coarsened );
+      Dune::AdaptationStatistics::Timer timer( statistics.callbackTime );
+
       //father.resetRefinedTag();
       realFather_.setElement( father );
       rp_.preCoarsening( reFather_ );
@@ -75,6 +81,11 @@ namespace ALU2DSPACENAME
     int postRefinement ( HElementType &father )
     {
       maxlevel_ = std::max( maxlevel_, father.level()+1 );
+
+      Dune::AdaptationStatistics &statistics = grid_.adaptationStatistics();
+      Dune::AdaptationStatistics::count( statistics.refined );
+      Dune::AdaptationStatistics::Timer timer( statistics.callbackTime );
+
       //father.resetRefinedTag();
       realFather_.setElement( father );
       rp_.postRefinement( reFather_ );
@@ -18,6 +18,7 @@
 #include <dune/grid/alugrid/common/declaration.hh>
 #include <dune/grid/alugrid/common/defaultindexsets.hh>
 #include <dune/grid/common/sizecache.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 #include <dune/grid/common/defaultgridview.hh>
 #include <dune/common/parallel/mpihelper.hh>
 
@@ -494,6 +495,16 @@ namespace Dune {
     template< class GridImp, class DataHandle >
     bool adapt ( AdaptDataHandleInterface< GridImp, DataHandle > &handle );
 
+    /** \brief obtain counters and timers of the adaptation process
+     *
+     *  \note Refined and coarsened elements are only counted if adapt is
+     *        called with a data handle.
+     */
+    const AdaptationStatistics &adaptationStatistics () const { return adaptationStatistics_; }
+
+    //! obtain counters and timers of the adaptation process (e.g., to reset them)
+    AdaptationStatistics &adaptationStatistics () { return adaptationStatistics_; }
+
     // refine grid
     bool refineGrid();
 
@@ -584,6 +595,9 @@ namespace Dune {
     // flag to make sure postAdapt is called after adapt
     bool lockPostAdapt_;
 
+    // counters and timers of the adaptation process
+    AdaptationStatistics adaptationStatistics_;
+
     // pointer to Dune boundary projection
     const DuneBoundaryProjectionType* bndPrj_;
 
@@ -319,6 +319,7 @@ namespace Dune
     ///////////////////////////////////////////////
     // update existing index sets
     ///////////////////////////////////////////////
+    AdaptationStatistics::Timer timer( adaptationStatistics_.indexSetTime );
     const int levelSize = levelIndexVec_.size();
     for(int i=0; i<levelSize; ++i)
     {
@@ -399,6 +400,9 @@ namespace Dune
     if( refCount <= 0 )
       return;
 
+    AdaptationStatistics::Timer timer( adaptationStatistics_.globalRefineTime );
+    const long oldElements = size( 0 );
+
     for (int j = 0; j < refCount; ++j)
     {
       ALU2DSPACE Listwalkptr< HElementType > walk( mesh() );
@@ -424,6 +428,7 @@ namespace Dune
 
     //update data
     updateStatus();
+    adaptationStatistics_.changeElements( oldElements, size( 0 ) );
 
     // cleanup markers
     postAdapt();
@@ -437,6 +442,7 @@ namespace Dune
   ::globalRefine ( int refCount, AdaptDataHandleInterface< GridImp, DataHandle > &handle )
   {
     assert( (refCount + maxLevel()) < MAXL );
+    AdaptationStatistics::Timer timer( adaptationStatistics_.globalRefineTime );
 
     for( int count = refCount; count > 0; --count )
     {
@@ -452,6 +458,7 @@ namespace Dune
   //! returns true if a least one entity was marked for coarseing
   template< int dim, int dimworld, ALU2DSPACE ElementType eltype >
   inline bool ALU2dGrid< dim, dimworld, eltype >::preAdapt () {
+    AdaptationStatistics::Timer timer( adaptationStatistics_.preAdaptTime );
     return (coarsenMarked_ > 0);
   }
 
@@ -476,6 +483,8 @@ namespace Dune
   template< int dim, int dimworld, ALU2DSPACE ElementType eltype >
   inline void ALU2dGrid< dim, dimworld, eltype >::postAdapt ()
   {
+    AdaptationStatistics::Timer timer( adaptationStatistics_.postAdaptTime );
+
     // clear refinement markers throughout the grid
     typedef ALU2DSPACE Macro < ElementType > macro_t;
 
@@ -504,6 +513,8 @@ namespace Dune
   template< int dim, int dimworld, ALU2DSPACE ElementType eltype >
   inline bool ALU2dGrid< dim, dimworld, eltype >::adapt ()
   {
+    AdaptationStatistics::Timer timer( adaptationStatistics_.adaptTime );
+    AdaptationStatistics::count( adaptationStatistics_.adaptCalls );
 
 #if ALU2DGRID_PARALLEL
     // make marking of ghost elements
@@ -521,10 +532,12 @@ namespace Dune
       // refine only will be done if
       // at least one element was marked for refinement
       bool adapted = (refineMarked_) ? true : false;
+      const long oldElements = size( 0 );
       mesh().refine();
       mesh().coarse();
 
       updateStatus();
+      adaptationStatistics_.changeElements( oldElements, size( 0 ) );
 
       // notify that postAdapt must be called
       lockPostAdapt_ = true;
@@ -548,6 +561,10 @@ namespace Dune
   {
     typedef AdaptDataHandleInterface< GridImp, DataHandle > AdaptDataHandle;
 
+    AdaptationStatistics::Timer timer( adaptationStatistics_.adaptTime );
+    AdaptationStatistics::count( adaptationStatistics_.adaptCalls );
+    const long oldElements = size( 0 );
+
     typedef typename EntityObject::ImplementationType EntityImp;
     EntityObject father( EntityImp( factory(), this->maxLevel()) );
     EntityObject son   ( EntityImp( factory(), this->maxLevel()) );
@@ -559,7 +576,10 @@ namespace Dune
     int newElements = std::max( actChunk , defaultChunk );
 
     // reserve memory
-    handle.preAdapt( newElements );
+    {
+      AdaptationStatistics::Timer callbackTimer( adaptationStatistics_.callbackTime );
+      handle.preAdapt( newElements );
+    }
 
 #if ALU2DGRID_PARALLEL
     // make marking of ghost elements
@@ -581,10 +601,14 @@ namespace Dune
 
     if(ref) {
       updateStatus();
+      adaptationStatistics_.changeElements( oldElements, size( 0 ) );
     }
 
     // check whether we have balance
-    handle.postAdapt();
+    {
+      AdaptationStatistics::Timer callbackTimer( adaptationStatistics_.callbackTime );
+      handle.postAdapt();
+    }
 
     postAdapt();
     return ref;
@@ -597,8 +621,16 @@ namespace Dune
     bool marked = this->getRealImplementation(en).mark(refCount);
     if(marked)
     {
-      if(refCount > 0) ++refineMarked_;
-      if(refCount < 0) ++coarsenMarked_;
+      if(refCount > 0)
+      {
+        ++refineMarked_;
+        AdaptationStatistics::count( adaptationStatistics_.markedForRefinement );
+      }
+      if(refCount < 0)
+      {
+        ++coarsenMarked_;
+        AdaptationStatistics::count( adaptationStatistics_.markedForCoarsening );
+      }
     }
     return marked;
   }
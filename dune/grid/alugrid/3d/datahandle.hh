@@ -4,12 +4,21 @@
 #define DUNE_ALU3DGRIDDATAHANDLE_HH
 
 //- system includes
+#include <cassert>
+#include <cstddef>
 #include <iostream>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/typetraits.hh>
 
 #include <dune/grid/common/grid.hh>
+#include <dune/grid/common/datahandleif.hh>
 #include <dune/grid/common/adaptcallback.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 
 //- local includes
+#include <dune/grid/alugrid/common/interfaces.hh>
 #include "alu3dinclude.hh"
 
 using std::endl;
@@ -19,6 +28,192 @@ using std::flush;
 namespace ALUGridSpace
 {
 
+  /** \brief message buffer accessing reserved space of an object stream
+   *
+   *  The data items are copied without the length checks of the object
+   *  stream. Writing (reading) more items than reserved throws an exception
+   *  before the stream is accessed.
+   */
+  template< class ObjectStreamType, class DataType >
+  class ReservedObjectStream
+  {
+  public:
+    //! constructor (size is the number of data items reserved)
+    ReservedObjectStream ( ObjectStreamType &str, std::size_t size )
+      : str_( str ), size_( size )
+    {}
+
+    void write ( const DataType &x )
+    {
+      if( size_ == 0 )
+        DUNE_THROW( Dune::InvalidStateException, "Data handle writes more data items than given by size()." );
+      --size_;
+      str_.writeT( x, false );
+    }
+
+    void read ( DataType &x )
+    {
+      if( size_ == 0 )
+        DUNE_THROW( Dune::InvalidStateException, "Data handle reads more data items than received." );
+      --size_;
+      str_.readT( x, false );
+    }
+
+    //! number of reserved data items not written (read), yet
+    std::size_t remaining () const { return size_; }
+
+  private:
+    ObjectStreamType &str_;
+    std::size_t size_;
+  };
+
+
+  //! message buffer writing (reading) the data items of one entity to (from) a vector
+  template< class DataType >
+  class EntityDataBuffer
+  {
+  public:
+    //! constructor (the size of data is the number of data items)
+    explicit EntityDataBuffer ( std::vector< DataType > &data )
+      : data_( data ), position_( 0 )
+    {}
+
+    void write ( const DataType &x )
+    {
+      if( position_ == data_.size() )
+        DUNE_THROW( Dune::InvalidStateException, "Data handle writes more data items than given by size()." );
+      data_[ position_++ ] = x;
+    }
+
+    void read ( DataType &x )
+    {
+      if( position_ == data_.size() )
+        DUNE_THROW( Dune::InvalidStateException, "Data handle reads more data items than received." );
+      x = data_[ position_++ ];
+    }
+
+    //! number of data items not written (read), yet
+    std::size_t remaining () const { return data_.size() - position_; }
+
+  private:
+    std::vector< DataType > &data_;
+    std::size_t position_;
+  };
+
+
+  //! detect data handles providing gatherBatch and scatterBatch (see Dune::HasBatchGatherScatter)
+  template< class DataCollectorType >
+  struct BatchGatherScatterTraits
+  {
+    static const bool value = false;
+    typedef DataCollectorType DataHandleImpl;
+  };
+
+  template< class DataHandleImpl_, class Data >
+  struct BatchGatherScatterTraits< Dune::CommDataHandleIF< DataHandleImpl_, Data > >
+  {
+    static const bool value = Dune::Conversion< DataHandleImpl_, Dune::HasBatchGatherScatter >::exists;
+    typedef DataHandleImpl_ DataHandleImpl;
+  };
+
+
+  /** \brief gather and scatter the data of one entity
+   *
+   *  All data items of an entity are collected in a reused vector and then
+   *  written to the object stream as one block, so that the stream checks
+   *  its length only once per entity. Data handles deriving from
+   *  Dune::HasBatchGatherScatter fill (read) this vector in one call.
+   *
+   *  If a data handle writes a different number of items than given by its
+   *  size() method, an exception is thrown before anything is written to
+   *  the stream.
+   *
+   *  \note The size of a message is not known here, since the ALU library
+   *        loops over the entities of each link itself. The object stream
+   *        grows on its own when a block is written.
+   */
+  template< class DataCollectorType, class ObjectStreamType >
+  class GatherScatterEntityData
+  {
+    typedef typename DataCollectorType::DataType DataType;
+
+    typedef BatchGatherScatterTraits< DataCollectorType > Traits;
+    typedef typename Traits::DataHandleImpl DataHandleImpl;
+    typedef Dune::integral_constant< bool, Traits::value > Batch;
+
+  public:
+    GatherScatterEntityData ( DataCollectorType &dc, bool variableSize )
+      : dc_( dc ), variableSize_( variableSize )
+    {}
+
+    //! write the data of an entity to the stream
+    template< class Entity >
+    void gather ( ObjectStreamType &str, const Entity &entity )
+    {
+      const std::size_t size = dc_.size( entity );
+      buffer_.resize( size );
+      if( size > 0 )
+        gather( entity, Batch() );
+
+      // in case of variable size, also send size
+      if( variableSize_ )
+        str.write( size );
+      if( size > 0 )
+        str.write( reinterpret_cast< const char * >( &buffer_[ 0 ] ), size*sizeof( DataType ) );
+    }
+
+    //! read the data of an entity from the stream
+    template< class Entity >
+    void scatter ( ObjectStreamType &str, const Entity &entity )
+    {
+      std::size_t size;
+      if( variableSize_ )
+        str.read( size );
+      else
+        size = dc_.size( entity );
+
+      buffer_.resize( size );
+      if( size > 0 )
+        str.read( reinterpret_cast< char * >( &buffer_[ 0 ] ), size*sizeof( DataType ) );
+      scatter( entity, size, Batch() );
+    }
+
+  private:
+    template< class Entity >
+    void gather ( const Entity &entity, Dune::false_type )
+    {
+      EntityDataBuffer< DataType > buffer( buffer_ );
+      dc_.gather( buffer, entity );
+      if( buffer.remaining() > 0 )
+        DUNE_THROW( Dune::InvalidStateException, "Data handle writes fewer data items than given by size()." );
+    }
+
+    template< class Entity >
+    void gather ( const Entity &entity, Dune::true_type )
+    {
+      static_cast< const DataHandleImpl & >( dc_ ).gatherBatch( entity, &buffer_[ 0 ] );
+    }
+
+    template< class Entity >
+    void scatter ( const Entity &entity, std::size_t size, Dune::false_type )
+    {
+      EntityDataBuffer< DataType > buffer( buffer_ );
+      dc_.scatter( buffer, entity, size );
+    }
+
+    template< class Entity >
+    void scatter ( const Entity &entity, std::size_t size, Dune::true_type )
+    {
+      if( size > 0 )
+        static_cast< DataHandleImpl & >( dc_ ).scatterBatch( entity, &buffer_[ 0 ], size );
+    }
+
+    DataCollectorType &dc_;
+    const bool variableSize_;
+    std::vector< DataType > buffer_;
+  };
+
+
   //! the corresponding interface class is defined in bsinclude.hh
   template <class GridType, class DataCollectorType, int codim >
   class GatherScatterBaseImpl
@@ -48,6 +243,8 @@ namespace ALUGridSpace
 
     typedef typename DataCollectorType:: DataType DataType;
 
+    GatherScatterEntityData< DataCollectorType, ObjectStreamType > entityData_;
+
     using GatherScatter :: setData ;
     using GatherScatter :: sendData ;
     using GatherScatter :: recvData ;
@@ -59,6 +256,7 @@ namespace ALUGridSpace
                           RealEntityType & realEntity , DataCollectorType & dc)
       : grid_(grid), entity_(en), realEntity_(realEntity) , dc_(dc)
         , variableSize_( ! dc_.fixedsize(EntityType::dimension,codim) )
+        , entityData_( dc_, variableSize_ )
     {}
 
     //! returns contains of dc_
@@ -82,9 +280,8 @@ namespace ALUGridSpace
       // make sure partition type is set correct
       assert( elem.isGhost() == (entity_.partitionType() == Dune :: GhostEntity) );
 
-      size_t size = getSize(str, entity_);
       // use normal scatter method
-      dc_.scatter(str,entity_, size );
+      entityData_.scatter( str, entity_ );
     }
 
     //! write Data of one element to stream
@@ -94,14 +291,7 @@ namespace ALUGridSpace
       //assert( this->containsItem( elem ) );
       setElement(elem);
 
-      // if varaible size, also send size
-      if( variableSize_ )
-      {
-        size_t size = dc_.size( entity_ );
-        str.write( size );
-      }
-
-      dc_.gather(str, entity_ );
+      entityData_.gather( str, entity_ );
     }
 
     //! read Data of one element from stream
@@ -110,21 +300,7 @@ namespace ALUGridSpace
       assert( this->containsItem( elem ) );
       setElement( elem );
 
-      size_t size = getSize(str, entity_);
-      dc_.scatter(str,entity_, size );
-    }
-
-  protected:
-    size_t getSize(ObjectStreamType & str, EntityType & en)
-    {
-      if(variableSize_)
-      {
-        size_t size;
-        str.read(size);
-        return size;
-      }
-      else
-        return dc_.size(en);
+      entityData_.scatter( str, entity_ );
     }
   };
 
@@ -170,6 +346,8 @@ namespace ALUGridSpace
     // used MessageBuffer
     typedef typename GatherScatter :: ObjectStreamType ObjectStreamType;
 
+    GatherScatterEntityData< DataCollectorType, ObjectStreamType > entityData_;
+
     // use all other containsItem from the base class
     using GatherScatter :: setData ;
     using GatherScatter :: sendData ;
@@ -184,6 +362,7 @@ namespace ALUGridSpace
                           RealEntityType & realEntity , DataCollectorType & dc)
       : grid_(grid), entity_(en), realEntity_(realEntity)
         , dc_(dc) , variableSize_ ( ! dc_.fixedsize( EntityType :: dimension, codim ))
+        , entityData_( dc_, variableSize_ )
     {}
 
     // return true if dim,codim combination is contained in data set
@@ -207,10 +386,8 @@ namespace ALUGridSpace
       assert( this->containsItem(elem) );
       realEntity_.setElement( const_cast<HElementType &> (elem) );
 
-      // write size in case of variable size
-      writeSize( str, entity_);
-      // gather data
-      dc_.gather(str, entity_);
+      // gather data (and size in case of variable size)
+      entityData_.gather( str, entity_ );
     }
 
     //! write Data of one ghost element to stream
@@ -221,10 +398,8 @@ namespace ALUGridSpace
       // set ghost as entity
       realEntity_.setGhost( const_cast <HGhostType &> (ghost) );
 
-      // write size in case of variable size
-      writeSize( str, entity_);
-      // gather data
-      dc_.gather(str, entity_);
+      // gather data (and size in case of variable size)
+      entityData_.gather( str, entity_ );
     }
 
     //! read Data of one element from stream
@@ -233,8 +408,7 @@ namespace ALUGridSpace
       // assert( this->containsItem( elem ) );
       realEntity_.setElement( elem );
 
-      size_t size = getSize(str, entity_);
-      dc_.scatter(str, entity_, size);
+      entityData_.scatter( str, entity_ );
     }
 
     //! read Data of one element from stream
@@ -245,31 +419,7 @@ namespace ALUGridSpace
       // set ghost as entity
       realEntity_.setGhost( ghost );
 
-      size_t size = getSize(str , entity_ );
-      dc_.scatter(str, entity_, size );
-    }
-
-  protected:
-    size_t getSize(ObjectStreamType & str, EntityType & en)
-    {
-      if(variableSize_)
-      {
-        size_t size;
-        str.read(size);
-        return size;
-      }
-      else
-        return dc_.size(en);
-    }
-
-    // write variable size to stream
-    void writeSize(ObjectStreamType & str, EntityType & en)
-    {
-      if( variableSize_ )
-      {
-        size_t size = dc_.size( en );
-        str.write( size );
-      }
+      entityData_.scatter( str, entity_ );
     }
   };
 
@@ -628,6 +778,10 @@ namespace ALUGridSpace
     //! restrict data for elements
     int preCoarsening ( HElementType & father )
     {
+      Dune::AdaptationStatistics &statistics = grid_.adaptationStatistics();
+      Dune::AdaptationStatistics::count( statistics.coarsened );
+      Dune::AdaptationStatistics::Timer timer( statistics.callbackTime );
+
       realFather_.setElement( father );
       rp_.preCoarsening( reFather_ );
 
@@ -639,6 +793,10 @@ namespace ALUGridSpace
     //! prolong data for elements
     int postRefinement ( HElementType & father )
     {
+      Dune::AdaptationStatistics &statistics = grid_.adaptationStatistics();
+      Dune::AdaptationStatistics::count( statistics.refined );
+      Dune::AdaptationStatistics::Timer timer( statistics.callbackTime );
+
       realFather_.setElement( father );
       rp_.postRefinement( reFather_ );
 
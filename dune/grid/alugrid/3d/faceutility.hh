@@ -3,6 +3,8 @@
 #ifndef DUNE_ALU3DGRIDFACEUTILITY_HH
 #define DUNE_ALU3DGRIDFACEUTILITY_HH
 
+#include <vector>
+
 #include <dune/geometry/referenceelements.hh>
 
 #include "mappings.hh"
@@ -112,6 +114,9 @@ namespace Dune
     //! Twist of the face seen from the outer element
     int outerTwist() const;
 
+    //! 0 if the inner element is the face's front neighbor, 1 if it is the rear one
+    int innerSide() const;
+
     //! Twist of the face seen from the inner element
     int duneTwist(const int faceIdx, const int aluTwist) const;
 
@@ -160,6 +165,8 @@ namespace Dune
     int innerTwist_;
     int outerTwist_;
 
+    int innerSide_;
+
     int segmentIndex_;
     int bndId_;
 
@@ -219,6 +226,104 @@ namespace Dune
 
 
 
+  // ALU3dGridFaceGeometryCache
+  // --------------------------
+
+  /** \brief cache for the geometric information of faces needed by the
+   *         intersection iterators
+   *
+   *  For each face and each of its two sides, the cache stores the corners
+   *  of the face in the reference elements of the inner and outer element
+   *  and, for affine faces, the integration outer normal and the
+   *  integration element. The entries are addressed by the hierarchic index
+   *  of the face and tagged with the face and its connectivity (face
+   *  numbers, twists and conformance state), so a mismatching entry is
+   *  simply recomputed.
+   *
+   *  The cache is disabled by default, because it needs roughly 200 (tetra)
+   *  or 250 (hexa) bytes per face and side. It is cleared by the grid after
+   *  each adaptation and load balancing. The side of an entry is the
+   *  neighbor slot (front or rear) of the inner element, so the two
+   *  neighbors of a face use distinct entries. Each entry is only written
+   *  while iterating over the intersections of the element in its slot, so
+   *  threads working on distinct elements do not interfere.
+   */
+  template< ALU3dGridElementType type >
+  class ALU3dGridFaceGeometryCache
+  {
+  public:
+    static const int numVerticesPerFace = EntityCount< type >::numVerticesPerFace;
+
+    typedef FieldVector< alu3d_ctype, 3 > NormalType;
+    typedef FieldMatrix< alu3d_ctype, numVerticesPerFace, 3 > CoordinateType;
+
+    //! cached geometric information of one side of a face
+    struct Entry
+    {
+      Entry () : face_( 0 ), localValid_( false ), normalValid_( false ) {}
+
+      //! return true if this entry describes the given view of a face
+      bool matches ( const void *face, int state, int innerFace, int innerTwist, int outerFace, int outerTwist ) const
+      {
+        return (face_ == face) && (key_[ 0 ] == state)
+               && (key_[ 1 ] == innerFace) && (key_[ 2 ] == innerTwist)
+               && (key_[ 3 ] == outerFace) && (key_[ 4 ] == outerTwist);
+      }
+
+      //! assign this entry to the given view of a face and invalidate it
+      void reset ( const void *face, int state, int innerFace, int innerTwist, int outerFace, int outerTwist )
+      {
+        face_ = face;
+        key_[ 0 ] = state;
+        key_[ 1 ] = innerFace;
+        key_[ 2 ] = innerTwist;
+        key_[ 3 ] = outerFace;
+        key_[ 4 ] = outerTwist;
+        localValid_ = normalValid_ = false;
+      }
+
+      const void *face_;
+      int key_[ 5 ];
+
+      bool localValid_;
+      CoordinateType selfLocal_;
+      CoordinateType neighborLocal_;
+
+      bool normalValid_;
+      NormalType normal_;
+      alu3d_ctype integrationElement_;
+    };
+
+    ALU3dGridFaceGeometryCache () : enabled_( false ) {}
+
+    //! return true if the cache is used
+    bool enabled () const { return enabled_; }
+
+    //! enable or disable the cache (entries are allocated by clear)
+    void enable ( bool enable ) { enabled_ = enable; }
+
+    //! invalidate all entries and, if enabled, allocate entries for numFaces faces
+    void clear ( int numFaces )
+    {
+      std::vector< Entry >().swap( entries_ );
+      if( enabled_ )
+        entries_.resize( 2*numFaces );
+    }
+
+    //! return entry for one side of a face (or 0, if the face is not cached)
+    Entry *entry ( int faceIndex, int side )
+    {
+      const std::size_t index = 2*std::size_t( faceIndex ) + side;
+      return (index < entries_.size() ? &entries_[ index ] : 0);
+    }
+
+  private:
+    bool enabled_;
+    std::vector< Entry > entries_;
+  };
+
+
+
   // ALU3dGridGeometricFaceInfoBase
   // ------------------------------
 
@@ -258,11 +363,14 @@ namespace Dune
 
     typedef typename ALU3dGridFaceInfo< type, Comm >::GEOFaceType GEOFaceType;
 
+    typedef ALU3dGridFaceGeometryCache< type > FaceGeometryCacheType;
+    typedef typename FaceGeometryCacheType::Entry FaceGeometryCacheEntryType;
+
   public:
     typedef ALU3dGridFaceInfo< type, Comm > ConnectorType;
 
     //- constructors and destructors
-    ALU3dGridGeometricFaceInfoBase(const ConnectorType &);
+    ALU3dGridGeometricFaceInfoBase(const ConnectorType &, FaceGeometryCacheType *cache = 0);
     ALU3dGridGeometricFaceInfoBase(const ALU3dGridGeometricFaceInfoBase &);
 
     //! reset status of faceGeomInfo
@@ -272,14 +380,25 @@ namespace Dune
     const CoordinateType& intersectionSelfLocal() const;
     const CoordinateType& intersectionNeighborLocal() const;
 
+    //! integration element of the face, given its integration outer normal
+    alu3d_ctype integrationElement(const NormalType& outerNormal) const;
+
   private:
     //- forbidden methods
     const ALU3dGridGeometricFaceInfoBase &operator=(const ALU3dGridGeometricFaceInfoBase &);
 
+  protected:
+    //! entry of the face geometry cache for the current face (or 0, if not cached)
+    FaceGeometryCacheEntryType *cacheEntry() const;
+
   private:
     //- private methods
     void generateLocalGeometries() const;
 
+    //! generate local geometries or take them from the cache
+    //! \returns the cache entry holding them (or 0, if not cached)
+    const FaceGeometryCacheEntryType *cachedLocalGeometries() const;
+
     int globalVertexIndex(const int duneFaceIndex,
                           const int faceTwist,
                           const int duneFaceVertexIndex) const;
@@ -299,6 +418,11 @@ namespace Dune
     mutable bool generatedGlobal_;
     mutable bool generatedLocal_;
 
+    // cache shared by all intersection iterators of the grid (may be 0)
+    FaceGeometryCacheType *cache_;
+    mutable FaceGeometryCacheEntryType *cacheEntry_;
+    mutable bool cacheSearched_;
+
     inline static const ReferenceElementType& getReferenceElement()
     {
       return (type == tetra) ?
@@ -329,9 +453,11 @@ namespace Dune
     typedef typename ALU3dGridFaceInfo< tetra, Comm >::GEOFaceType GEOFaceType;
 
     typedef ALU3dGridFaceInfo< tetra, Comm > ConnectorType;
+    typedef typename Base::FaceGeometryCacheType FaceGeometryCacheType;
+    typedef typename Base::FaceGeometryCacheEntryType FaceGeometryCacheEntryType;
 
     //- constructors and destructors
-    ALU3dGridGeometricFaceInfoTetra(const ConnectorType& ctor);
+    ALU3dGridGeometricFaceInfoTetra(const ConnectorType& ctor, FaceGeometryCacheType *cache = 0);
     ALU3dGridGeometricFaceInfoTetra(const ALU3dGridGeometricFaceInfoTetra & orig);
 
     NormalType & outerNormal(const FieldVector<alu3d_ctype, 2>& local) const;
@@ -374,9 +500,11 @@ namespace Dune
     typedef SurfaceNormalCalculator SurfaceMappingType;
 
     typedef ALU3dGridFaceInfo< hexa, Comm > ConnectorType;
+    typedef typename Base::FaceGeometryCacheType FaceGeometryCacheType;
+    typedef typename Base::FaceGeometryCacheEntryType FaceGeometryCacheEntryType;
 
     //- constructors and destructors
-    ALU3dGridGeometricFaceInfoHexa(const ConnectorType &);
+    ALU3dGridGeometricFaceInfoHexa(const ConnectorType &, FaceGeometryCacheType *cache = 0);
     ALU3dGridGeometricFaceInfoHexa(const ALU3dGridGeometricFaceInfoHexa &);
 
     NormalType & outerNormal(const FieldVector<alu3d_ctype, 2>& local) const;
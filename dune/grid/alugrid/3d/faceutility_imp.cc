@@ -17,6 +17,7 @@ namespace Dune
     outerFaceNumber_(-1),
     innerTwist_(-665),
     outerTwist_(-665),
+    innerSide_(-1),
     segmentIndex_( -1 ),
     bndId_( -1 ),
     bndType_( noBoundary ),
@@ -50,6 +51,7 @@ namespace Dune
       innerFaceNumber_ = face.nb.rear().second;
       outerElement_    = face.nb.front().first;
       outerFaceNumber_ = face.nb.front().second;
+      innerSide_ = 1;
     }
     else
     {
@@ -57,6 +59,7 @@ namespace Dune
       innerFaceNumber_ = face.nb.front().second;
       outerElement_    = face.nb.rear().first;
       outerFaceNumber_ = face.nb.rear().second;
+      innerSide_ = 0;
     } // end if
 
     // if not true we are accessing a fake bnd
@@ -247,6 +250,7 @@ namespace Dune
       outerFaceNumber_(orig.outerFaceNumber_),
       innerTwist_(orig.innerTwist_),
       outerTwist_(orig.outerTwist_),
+      innerSide_(orig.innerSide_),
       segmentIndex_( orig.segmentIndex_ ),
       bndId_( orig.bndId_ ),
       bndType_( orig.bndType_ ),
@@ -386,6 +390,13 @@ namespace Dune
     return outerTwist_;
   }
 
+  template< ALU3dGridElementType type, class Comm >
+  inline int ALU3dGridFaceInfo< type, Comm >::innerSide() const
+  {
+    assert( (innerSide_ == 0) || (innerSide_ == 1) );
+    return innerSide_;
+  }
+
   template< ALU3dGridElementType type, class Comm >
   inline int ALU3dGridFaceInfo< type, Comm >::innerALUFaceIndex() const {
     return innerFaceNumber_;
@@ -434,12 +445,15 @@ namespace Dune
 
   template< ALU3dGridElementType type, class Comm >
   inline ALU3dGridGeometricFaceInfoBase< type, Comm >::
-  ALU3dGridGeometricFaceInfoBase(const ConnectorType& connector) :
+  ALU3dGridGeometricFaceInfoBase(const ConnectorType& connector, FaceGeometryCacheType *cache) :
     connector_(connector),
     coordsSelfLocal_(-1.0),
     coordsNeighborLocal_(-1.0),
     generatedGlobal_(false),
-    generatedLocal_(false)
+    generatedLocal_(false),
+    cache_(cache),
+    cacheEntry_(0),
+    cacheSearched_(false)
   {}
 
   template< ALU3dGridElementType type, class Comm >
@@ -449,6 +463,7 @@ namespace Dune
   {
     generatedGlobal_ = false;
     generatedLocal_  = false;
+    cacheSearched_   = false;
   }
 
   template< ALU3dGridElementType type, class Comm >
@@ -458,13 +473,18 @@ namespace Dune
       coordsSelfLocal_(orig.coordsSelfLocal_),
       coordsNeighborLocal_(orig.coordsNeighborLocal_),
       generatedGlobal_(orig.generatedGlobal_),
-      generatedLocal_(orig.generatedLocal_)
+      generatedLocal_(orig.generatedLocal_),
+      cache_(orig.cache_),
+      cacheEntry_(0),
+      cacheSearched_(false)
   {}
 
   template< ALU3dGridElementType type, class Comm >
   inline const typename ALU3dGridGeometricFaceInfoBase< type, Comm >::CoordinateType&
   ALU3dGridGeometricFaceInfoBase< type, Comm >::intersectionSelfLocal() const {
-    generateLocalGeometries();
+    const FaceGeometryCacheEntryType *entry = cachedLocalGeometries();
+    if( entry )
+      return entry->selfLocal_;
     assert(generatedLocal_);
     return coordsSelfLocal_;
   }
@@ -473,17 +493,74 @@ namespace Dune
   inline const typename ALU3dGridGeometricFaceInfoBase< type, Comm >::CoordinateType&
   ALU3dGridGeometricFaceInfoBase< type, Comm >::intersectionNeighborLocal() const {
     assert(!connector_.outerBoundary());
-    generateLocalGeometries();
+    const FaceGeometryCacheEntryType *entry = cachedLocalGeometries();
+    if( entry )
+      return entry->neighborLocal_;
     assert(generatedLocal_);
     return coordsNeighborLocal_;
   }
 
+  template< ALU3dGridElementType type, class Comm >
+  inline alu3d_ctype
+  ALU3dGridGeometricFaceInfoBase< type, Comm >::
+  integrationElement(const NormalType& outerNormal) const
+  {
+    // the normal has just been computed, so the entry is valid if the face is affine
+    const FaceGeometryCacheEntryType *entry = cacheEntry();
+    return (entry && entry->normalValid_) ? entry->integrationElement_ : outerNormal.two_norm();
+  }
+
+  template< ALU3dGridElementType type, class Comm >
+  inline typename ALU3dGridGeometricFaceInfoBase< type, Comm >::FaceGeometryCacheEntryType *
+  ALU3dGridGeometricFaceInfoBase< type, Comm >::cacheEntry() const
+  {
+    if( !cacheSearched_ )
+    {
+      cacheEntry_ = 0;
+      if( cache_ && cache_->enabled() )
+      {
+        const GEOFaceType &face = connector_.face();
+        // separate the two sides of the face by the neighbor slot of the
+        // inner element (the inner twist may be replaced by a ghost's twist)
+        cacheEntry_ = cache_->entry( face.getIndex(), connector_.innerSide() );
+        if( cacheEntry_ && !cacheEntry_->matches( &face, connector_.conformanceState(),
+                                                  connector_.innerALUFaceIndex(), connector_.innerTwist(),
+                                                  connector_.outerALUFaceIndex(), connector_.outerTwist() ) )
+        {
+          cacheEntry_->reset( &face, connector_.conformanceState(),
+                              connector_.innerALUFaceIndex(), connector_.innerTwist(),
+                              connector_.outerALUFaceIndex(), connector_.outerTwist() );
+        }
+      }
+      cacheSearched_ = true;
+    }
+    return cacheEntry_;
+  }
+
+  template< ALU3dGridElementType type, class Comm >
+  inline const typename ALU3dGridGeometricFaceInfoBase< type, Comm >::FaceGeometryCacheEntryType *
+  ALU3dGridGeometricFaceInfoBase< type, Comm >::cachedLocalGeometries() const
+  {
+    FaceGeometryCacheEntryType *entry = cacheEntry();
+    if( entry && entry->localValid_ )
+      return entry;
+
+    generateLocalGeometries();
+    if( entry )
+    {
+      entry->selfLocal_ = coordsSelfLocal_;
+      entry->neighborLocal_ = coordsNeighborLocal_;
+      entry->localValid_ = true;
+    }
+    return entry;
+  }
+
 
   //sepcialisation for tetra and hexa
   template< class Comm >
   inline ALU3dGridGeometricFaceInfoTetra< Comm >::
-  ALU3dGridGeometricFaceInfoTetra(const ConnectorType& connector)
-    : Base( connector ), normalUp2Date_( false )
+  ALU3dGridGeometricFaceInfoTetra(const ConnectorType& connector, FaceGeometryCacheType *cache)
+    : Base( connector, cache ), normalUp2Date_( false )
   {}
 
   template< class Comm >
@@ -527,6 +604,15 @@ namespace Dune
     // if geomInfo was not reseted then normal is still correct
     if(!normalUp2Date_)
     {
+      // the normal of a triangle is constant, so it can always be cached
+      FaceGeometryCacheEntryType *entry = this->cacheEntry();
+      if( entry && entry->normalValid_ )
+      {
+        outerNormal_ = entry->normal_;
+        normalUp2Date_ = true;
+        return outerNormal_;
+      }
+
       // calculate the normal
       const GEOFaceType & face = this->connector_.face();
       const alu3d_ctype (&_p0)[3] = face.myvertex(0)->Point();
@@ -542,6 +628,13 @@ namespace Dune
       outerNormal_[1] = factor * ((_p1[2]-_p0[2]) *(_p2[0]-_p1[0]) - (_p2[2]-_p1[2]) *(_p1[0]-_p0[0]));
       outerNormal_[2] = factor * ((_p1[0]-_p0[0]) *(_p2[1]-_p1[1]) - (_p2[0]-_p1[0]) *(_p1[1]-_p0[1]));
 
+      if( entry )
+      {
+        entry->normal_ = outerNormal_;
+        entry->integrationElement_ = outerNormal_.two_norm();
+        entry->normalValid_ = true;
+      }
+
       normalUp2Date_ = true;
     } // end if mapp ...
 
@@ -551,8 +644,8 @@ namespace Dune
   //-sepcialisation for and hexa
   template< class Comm >
   inline ALU3dGridGeometricFaceInfoHexa< Comm >::
-  ALU3dGridGeometricFaceInfoHexa(const ConnectorType& connector)
-    : Base( connector )
+  ALU3dGridGeometricFaceInfoHexa(const ConnectorType& connector, FaceGeometryCacheType *cache)
+    : Base( connector, cache )
       , mappingGlobal_()
       , mappingGlobalUp2Date_(false)
   {}
@@ -601,6 +694,14 @@ namespace Dune
     if ( mappingGlobal_.affine () && mappingGlobalUp2Date_ )
       return outerNormal_ ;
 
+    // the normal of an affine face may be cached
+    FaceGeometryCacheEntryType *entry = this->cacheEntry();
+    if( entry && entry->normalValid_ )
+    {
+      outerNormal_ = entry->normal_;
+      return outerNormal_;
+    }
+
     // update surface mapping
     if(! mappingGlobalUp2Date_ )
     {
@@ -623,6 +724,13 @@ namespace Dune
     else
       mappingGlobal_.normal(local,outerNormal_);
 
+    if( entry && mappingGlobal_.affine() )
+    {
+      entry->normal_ = outerNormal_;
+      entry->integrationElement_ = outerNormal_.two_norm();
+      entry->normalValid_ = true;
+    }
+
     // end if
     return outerNormal_;
   }
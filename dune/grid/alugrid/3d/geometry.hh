@@ -766,19 +766,39 @@ namespace Dune
     // type of object provider
     typedef ALUMemoryProvider< GeometryImplType > GeometryProviderType ;
 
+    // type of storage (one provider per thread)
+#ifdef USE_SMP_PARALLEL
+    typedef ALUThreadLocalMemoryProvider< GeometryImplType, ALUGridObjectFactory< GridImp > > GeometryStorageType;
+#else
+    typedef GeometryProviderType GeometryStorageType;
+#endif
+
+    //! return storage of geometry objects
+    static GeometryStorageType& geoStorage()
+    {
+      static GeometryStorageType storage;
+      return storage;
+    }
+
     //! return storage provider for geometry objects
     static GeometryProviderType& geoProvider()
     {
 #ifdef USE_SMP_PARALLEL
-      typedef ALUGridObjectFactory< GridImp >  GridObjectFactoryType;
-      static std::vector< GeometryProviderType > storage( GridObjectFactoryType :: maxThreads() );
-      return storage[ GridObjectFactoryType :: threadNumber () ];
+      return geoStorage()();
 #else
-      static GeometryProviderType storage;
-      return storage;
+      return geoStorage();
 #endif
     }
 
+  public:
+    //! return usage statistics of the storage of geometry implementations (summed over all threads)
+    static ALUMemoryProviderStatistics storageStatistics ()
+    {
+      return geoStorage().statistics();
+    }
+
+  protected:
+
     // return reference to geometry implementation
     GeometryImplType& geoImpl() const
     {
@@ -18,6 +18,7 @@
 #include <dune/grid/common/grid.hh>
 #include <dune/grid/alugrid/common/defaultindexsets.hh>
 #include <dune/grid/common/sizecache.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 #include <dune/grid/alugrid/common/intersectioniteratorwrapper.hh>
 #include <dune/grid/common/datahandleif.hh>
 #include <dune/grid/common/defaultgridview.hh>
@@ -31,6 +32,7 @@
 //- Local includes
 #include "alu3dinclude.hh"
 #include "topology.hh"
+#include "faceutility.hh"
 #include "indexsets.hh"
 #include "datahandle.hh"
 
@@ -482,6 +484,9 @@ namespace Dune
     //! Type of the hierarchic index set
     typedef ALU3dGridHierarchicIndexSet< elType, Comm > HierarchicIndexSet;
 
+    //! Type of the cache for the face geometries of the intersections
+    typedef ALU3dGridFaceGeometryCache< elType > FaceGeometryCacheType;
+
     //! Type of the level index set, needed by data handle
     typedef typename GridFamily::LevelIndexSetImp LevelIndexSetImp;
     //! Type of the leaf index set, needed by data handle
@@ -806,6 +811,33 @@ namespace Dune
     template< class GridImp, class DataHandle >
     void globalRefine ( int refCount, AdaptDataHandleInterface< GridImp, DataHandle > &handle );
 
+    /** \brief obtain counters and timers of the adaptation process
+     *
+     *  \note Refined and coarsened elements are only counted if adapt is
+     *        called with a data handle.
+     */
+    const AdaptationStatistics &adaptationStatistics () const { return adaptationStatistics_; }
+
+    //! obtain counters and timers of the adaptation process (e.g., to reset them)
+    AdaptationStatistics &adaptationStatistics () { return adaptationStatistics_; }
+
+    /** \brief enable or disable caching of the face geometries of intersections
+     *
+     *  If enabled, the intersection iterators store the local geometries of
+     *  each face in both neighbors and, for affine faces, the outer normal
+     *  and the integration element. Repeated sweeps over the intersections
+     *  (as in DG flux computations) then take them from the cache instead
+     *  of recomputing them. The cache is cleared on each adaptation and
+     *  load balancing and costs up to 500 bytes per face.
+     */
+    void faceGeometryCaching ( bool enable );
+
+    //! return true if the face geometries of intersections are cached
+    bool faceGeometryCaching () const { return faceGeometryCache_.enabled(); }
+
+    // (no interface method) cache of the face geometries used by the intersection iterators
+    FaceGeometryCacheType &faceGeometryCache () const { return faceGeometryCache_; }
+
     //**********************************************************
     // End of Interface Methods
     //**********************************************************
@@ -1090,6 +1122,12 @@ namespace Dune
     // variable to ensure that postAdapt ist called after adapt
     bool lockPostAdapt_;
 
+    // counters and timers of the adaptation process
+    AdaptationStatistics adaptationStatistics_;
+
+    // cache of the face geometries of intersections (disabled by default)
+    mutable FaceGeometryCacheType faceGeometryCache_;
+
     // pointer to Dune boundary projection
     const DuneBoundaryProjectionType* bndPrj_;
 
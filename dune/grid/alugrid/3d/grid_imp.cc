@@ -385,24 +385,43 @@ namespace Dune
     }
 
     // update all index set that are already in use
-    for(size_t i=0; i<levelIndexVec_.size(); ++i)
     {
-      if(levelIndexVec_[i])
-        (*(levelIndexVec_[i])).calcNewIndex( this->template lbegin<0>( i ),
-                                             this->template lend<0>( i ) );
-    }
+      AdaptationStatistics::Timer timer( adaptationStatistics_.indexSetTime );
+      for(size_t i=0; i<levelIndexVec_.size(); ++i)
+      {
+        if(levelIndexVec_[i])
+          (*(levelIndexVec_[i])).calcNewIndex( this->template lbegin<0>( i ),
+                                               this->template lend<0>( i ) );
+      }
 
-    if(leafIndexSet_)
-      leafIndexSet_->calcNewIndex( this->template leafbegin<0>(), this->template leafend<0>() );
+      if(leafIndexSet_)
+        leafIndexSet_->calcNewIndex( this->template leafbegin<0>(), this->template leafend<0>() );
+    }
 
     // build global ID set new (to be revised)
-    if( globalIdSet_ ) globalIdSet_->updateIdSet();
+    if( globalIdSet_ )
+    {
+      AdaptationStatistics::Timer timer( adaptationStatistics_.idSetTime );
+      globalIdSet_->updateIdSet();
+    }
+
+    // cached face geometries refer to the old grid
+    faceGeometryCache_.clear( hierSetSize( 1 ) );
 
     coarsenMarked_ = 0;
     refineMarked_  = 0;
   }
 
 
+  template< ALU3dGridElementType elType, class Comm >
+  alu_inline
+  void ALU3dGrid< elType, Comm >::faceGeometryCaching ( bool enable )
+  {
+    faceGeometryCache_.enable( enable );
+    faceGeometryCache_.clear( hierSetSize( 1 ) );
+  }
+
+
   template< ALU3dGridElementType elType, class Comm >
   alu_inline
   const typename ALU3dGrid< elType, Comm >::Traits::LeafIndexSet &
@@ -440,6 +459,7 @@ namespace Dune
   void ALU3dGrid< elType, Comm >::globalRefine ( int refCount )
   {
     assert( (refCount + maxLevel()) < MAXL );
+    AdaptationStatistics::Timer timer( adaptationStatistics_.globalRefineTime );
 
     for( int count = refCount; count > 0; --count )
     {
@@ -457,6 +477,7 @@ namespace Dune
   alu_inline
   bool ALU3dGrid< elType, Comm >::preAdapt()
   {
+    AdaptationStatistics::Timer timer( adaptationStatistics_.preAdaptTime );
     return (coarsenMarked_ > 0);
   }
 
@@ -473,6 +494,10 @@ namespace Dune
       DUNE_THROW(InvalidStateException,"Make sure that postAdapt is called after adapt was called and returned true!");
     }
 
+    AdaptationStatistics::Timer timer( adaptationStatistics_.adaptTime );
+    AdaptationStatistics::count( adaptationStatistics_.adaptCalls );
+    const long oldElements = (leafIndexSet_ ? long( leafIndexSet_->size( 0 ) ) : 0);
+
     bool mightCoarse = preAdapt();
     // if prallel run, then adapt also global id set
     if(globalIdSet_)
@@ -503,6 +528,9 @@ namespace Dune
       // calcs maxlevel and other extras
       updateStatus();
 
+      if( leafIndexSet_ )
+        adaptationStatistics_.changeElements( oldElements, leafIndexSet_->size( 0 ) );
+
       // notify that postAdapt must be called
       lockPostAdapt_ = true;
     }
@@ -514,6 +542,7 @@ namespace Dune
   alu_inline
   void ALU3dGrid< elType, Comm >::postAdapt ()
   {
+    AdaptationStatistics::Timer timer( adaptationStatistics_.postAdaptTime );
     {
       // old fashioned way
       typedef ALU3DSPACE ALU3dGridLeafIteratorWrapper< 0, All_Partition, Comm > IteratorType;
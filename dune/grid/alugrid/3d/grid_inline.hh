@@ -301,8 +301,16 @@ namespace Dune
     bool marked = (this->getRealImplementation( entity )).mark(ref);
     if(marked)
     {
-      if(ref > 0) ++refineMarked_;
-      if(ref < 0) ++coarsenMarked_;
+      if(ref > 0)
+      {
+        ++refineMarked_;
+        AdaptationStatistics::count( adaptationStatistics_.markedForRefinement );
+      }
+      if(ref < 0)
+      {
+        ++coarsenMarked_;
+        AdaptationStatistics::count( adaptationStatistics_.markedForCoarsening );
+      }
     }
     return marked;
   }
@@ -325,6 +333,7 @@ namespace Dune
   ::globalRefine ( int refCount, AdaptDataHandleInterface< GridImp, DataHandle > &handle )
   {
     assert( (refCount + maxLevel()) < MAXL );
+    AdaptationStatistics::Timer timer( adaptationStatistics_.globalRefineTime );
 
     for( int count = refCount; count > 0; --count )
     {
@@ -346,6 +355,10 @@ namespace Dune
   {
     typedef AdaptDataHandleInterface< GridImp, DataHandle > AdaptDataHandle;
 
+    AdaptationStatistics::Timer timer( adaptationStatistics_.adaptTime );
+    AdaptationStatistics::count( adaptationStatistics_.adaptCalls );
+    const long oldElements = (leafIndexSet_ ? long( leafIndexSet_->size( 0 ) ) : 0);
+
     typedef typename EntityObject::ImplementationType EntityImp;
     EntityObject father( EntityImp( factory(), this->maxLevel() ) );
     EntityObject son   ( EntityImp( factory(), this->maxLevel() ) );
@@ -359,7 +372,10 @@ namespace Dune
     // true if at least one element was marked for coarsening
     bool mightCoarse = preAdapt();
     // reserve memory
-    handle.preAdapt( newElements );
+    {
+      AdaptationStatistics::Timer callbackTimer( adaptationStatistics_.callbackTime );
+      handle.preAdapt( newElements );
+    }
 
     bool refined = false ;
     if(globalIdSet_)
@@ -392,12 +408,18 @@ namespace Dune
       // refinement maxLevel was calculated already
       updateStatus();
 
+      if( leafIndexSet_ )
+        adaptationStatistics_.changeElements( oldElements, leafIndexSet_->size( 0 ) );
+
       // no need to call postAdapt here, because markers
       // are cleand during refinement callback
     }
 
     // check whether we have balance
-    handle.postAdapt();
+    {
+      AdaptationStatistics::Timer callbackTimer( adaptationStatistics_.callbackTime );
+      handle.postAdapt();
+    }
 
     // here postAdapt is not called, because
     // reset of refinedTag is done in preCoarsening and postRefinement
@@ -451,6 +473,9 @@ namespace Dune
       if( grid.comm().size() <= 1 )
         return false;
 
+      AdaptationStatistics::Timer timer( grid.adaptationStatistics().loadBalanceTime );
+      AdaptationStatistics::count( grid.adaptationStatistics().loadBalanceCalls );
+
       const bool changed = grid.myGrid().duneLoadBalance();
       if( changed )
       {
@@ -458,14 +483,9 @@ namespace Dune
         grid.myGrid().duneExchangeDynamicState();
 
         // calculate new maxlevel
-        // reset size and things
+        // reset size and things (this also updates the global id set)
         grid.updateStatus();
 
-        // build new Id Set. Only do that after updateStatus, because here
-        // the item lists are needed
-        if( grid.globalIdSet_ )
-          grid.globalIdSet_->updateIdSet();
-
         // unset all leaf markers
         grid.postAdapt();
       }
@@ -480,6 +500,9 @@ namespace Dune
       if( grid.comm().size() <= 1 )
         return false;
 
+      AdaptationStatistics::Timer timer( grid.adaptationStatistics().loadBalanceTime );
+      AdaptationStatistics::count( grid.adaptationStatistics().loadBalanceCalls );
+
       typedef typename Grid :: EntityObject EntityObject;
       typedef typename EntityObject::ImplementationType EntityImp;
       EntityObject en     ( EntityImp( grid.factory(), grid.maxLevel()) );
@@ -507,14 +530,9 @@ namespace Dune
         grid.myGrid().duneExchangeDynamicState();
 
         // calculate new maxlevel
-        // reset size and things
+        // reset size and things (this also updates the global id set)
         grid.updateStatus();
 
-        // build new Id Set. Only do that after updateStatus, because here
-        // the item lists are needed
-        if( grid.globalIdSet_ )
-          grid.globalIdSet_->updateIdSet();
-
         // compress data, wrapper for dof manager
         gs.compress();
 
@@ -4,6 +4,7 @@
 #define DUNE_ALU3DGRIDINDEXSETS_HH
 
 //- System includes
+#include <algorithm>
 #include <vector>
 
 //- Dune includes
@@ -356,9 +357,12 @@ namespace Dune {
 
     // this means that only up to 300000000 entities are allowed
     typedef typename GridType::Traits::template Codim<0>::Entity EntityCodim0Type;
+
+    // ids are stored contiguously, indexed by the hierarchic index
+    typedef std::vector< IdType > IdVectorType;
+
   private:
-    mutable std::map< int , IdType > ids_[numCodim];
-    //mutable std::map< int , MacroKeyType > macroKeys_[numCodim];
+    IdVectorType ids_[numCodim];
 
     // our Grid
     const GridType & grid_;
@@ -408,8 +412,14 @@ namespace Dune {
     // update id set after adaptation
     void updateIdSet()
     {
-      // to be revised
-      buildIdSet();
+      // In serial runs, the ids of all new entities have already been
+      // created during adaptation (see postRefinement), so we only need to
+      // adjust the storage. In parallel, ghost entities and migrated elements
+      // also change, so the id set is rebuilt completely.
+      if( grid_.comm().size() > 1 )
+        buildIdSet();
+      else
+        resizeIdSet();
     }
 
     // print all ids
@@ -435,14 +445,13 @@ namespace Dune {
       IdType id = getId(macroId);
       for(int i=0 ; i<numCodim; ++i)
       {
-        typedef typename std::map<int,IdType>::iterator IteratorType;
-        IteratorType end = ids_[i].end();
+        typedef typename IdVectorType::const_iterator IteratorType;
+        const IteratorType end = ids_[i].end();
         for(IteratorType it = ids_[i].begin(); it != end; ++it)
-        //for(unsigned int k=0; k<ids_[i].size(); ++k)
         {
           if(idIter == it) continue;
-          //if((i == codim) && (k == num)) continue;
-          const IdType & checkMId = (*it).second; //ids_[i][k];
+          const IdType & checkMId = *it;
+          if( !checkMId.isValid() ) continue;
           IdType checkId = getId(checkMId);
           if( id == checkId )
           {
@@ -471,12 +480,11 @@ namespace Dune {
     {
       for(int i=0 ; i<numCodim; i++)
       {
-        typedef typename std::map<int,IdType>::iterator IteratorType;
-        IteratorType end = ids_[i].end();
+        typedef typename IdVectorType::const_iterator IteratorType;
+        const IteratorType end = ids_[i].end();
         for(IteratorType it = ids_[i].begin(); it != end; ++it)
-        //unsigned int k=0; k<ids_[i].size(); ++k)
         {
-          const IdType & id = (*it).second; //ids_[i][k];
+          const IdType & id = *it;
           if( id.isValid() )
             checkId(id,it); //i,k);
         }
@@ -488,12 +496,20 @@ namespace Dune {
       chunkSize_ = chunkSize;
     }
 
+    // adjust the id storage to the current size of the hierarchic index set
+    void resizeIdSet ()
+    {
+      for(int i=0; i<numCodim; ++i)
+        ids_[i].resize( hset_.size( i ) );
+    }
+
     // creates the id set
     void buildIdSet ()
     {
       for(int i=0; i<numCodim; ++i)
       {
-        ids_[i].clear();
+        // invalidate all ids, the index set size is an upper bound of all indices
+        ids_[i].assign( hset_.size( i ), IdType() );
       }
 
       GitterImplType &gitter = grid_.myGrid();
@@ -504,7 +520,7 @@ namespace Dune {
         for( fw.first (); !fw.done(); fw.next() )
         {
           int idx = fw.item().getIndex();
-          ids_[3][idx] = buildMacroVertexId( fw.item() );
+          setId( 3, idx ) = buildMacroVertexId( fw.item() );
         }
       }
 
@@ -519,7 +535,7 @@ namespace Dune {
           assert( item.first );
           VertexType & vx = * (item.first);
           int idx = vx.getIndex();
-          ids_[3][idx] = buildMacroVertexId( vx );
+          setId( 3, idx ) = buildMacroVertexId( vx );
         }
       }
 
@@ -528,9 +544,8 @@ namespace Dune {
         typename ALU3DSPACE AccessIterator< HEdgeType >::Handle w( gitter.container() );
         for (w.first(); !w.done(); w.next())
         {
-          int idx = w.item().getIndex();
-          ids_[2][idx] = buildMacroEdgeId( w.item() );
-          buildEdgeIds( w.item() , ids_[2][idx] , startOffSet_ );
+          const IdType macroId = buildMacroEdgeId( w.item() );
+          buildEdgeIds( w.item() , macroId , startOffSet_ );
         }
       }
 
@@ -544,10 +559,8 @@ namespace Dune {
           val_t & item = fw.item();
           assert( item.first );
           HEdgeType & edge = * (item.first);
-          int idx = edge.getIndex();
-
-          ids_[2][idx] = buildMacroEdgeId( edge );
-          buildEdgeIds( edge , ids_[2][idx] , startOffSet_ );
+          const IdType macroId = buildMacroEdgeId( edge );
+          buildEdgeIds( edge , macroId , startOffSet_ );
         }
       }
 
@@ -557,9 +570,8 @@ namespace Dune {
         typename ALU3DSPACE AccessIterator< HFaceType >::Handle w( gitter.container() );
         for (w.first () ; ! w.done () ; w.next ())
         {
-          int idx = w.item().getIndex();
-          ids_[1][idx] = buildMacroFaceId( w.item() );
-          buildFaceIds( w.item() , ids_[1][idx] , startOffSet_ );
+          const IdType macroId = buildMacroFaceId( w.item() );
+          buildFaceIds( w.item() , macroId , startOffSet_ );
         }
       }
 
@@ -573,9 +585,8 @@ namespace Dune {
           val_t & item = fw.item();
           assert( item.first );
           HFaceType & face = * (item.first);
-          int idx = face.getIndex();
-          ids_[1][idx] = buildMacroFaceId( face );
-          buildFaceIds( face , ids_[1][idx] , startOffSet_ );
+          const IdType macroId = buildMacroFaceId( face );
+          buildFaceIds( face , macroId , startOffSet_ );
         }
       }
 
@@ -584,9 +595,8 @@ namespace Dune {
         typename ALU3DSPACE AccessIterator< HElementType >::Handle w( gitter.container() );
         for (w.first () ; ! w.done () ; w.next ())
         {
-          int idx = w.item().getIndex();
-          ids_[0][idx] = buildMacroElementId( w.item() );
-          buildElementIds( w.item() , ids_[0][idx] , startOffSet_ );
+          const IdType macroId = buildMacroElementId( w.item() );
+          buildElementIds( w.item() , macroId , startOffSet_ );
         }
       }
 
@@ -600,9 +610,8 @@ namespace Dune {
           val_t & item = fw.item();
           assert( item.second );
           HElementType & elem = * ( item.second->getGhost().first );
-          int idx = elem.getIndex();
-          ids_[0][idx] = buildMacroElementId( elem );
-          buildElementIds( elem , ids_[0][idx] , startOffSet_ );
+          const IdType macroId = buildMacroElementId( elem );
+          buildElementIds( elem , macroId , startOffSet_ );
         }
       }
 
@@ -616,6 +625,27 @@ namespace Dune {
 #endif
     }
 
+    // return storage for the id of the entity with given hierarchic index
+    // note: the storage might grow, so references to stored ids are invalidated
+    IdType &setId ( int codim, int index )
+    {
+      assert( index >= 0 );
+      IdVectorType &ids = ids_[ codim ];
+      if( index >= int( ids.size() ) )
+      {
+        // during adaptation the index set grows, so reserve a whole chunk
+        ids.resize( std::max( index+1, hset_.size( codim ) + chunkSize_ ) );
+      }
+      return ids[ index ];
+    }
+
+    // return the stored id of the entity with given hierarchic index
+    const IdType &storedId ( int codim, int index ) const
+    {
+      assert( (index >= 0) && (index < int( ids_[ codim ].size() )) );
+      return ids_[ codim ][ index ];
+    }
+
     IdType buildMacroVertexId(const VertexType & item )
     {
       int vx[4] = { item.ident(), -1, -1, -1};
@@ -692,9 +722,9 @@ namespace Dune {
     void buildElementIds(const HElementType & item , const IdType & macroId , int nChild)
     {
       enum { codim = 0 };
-      ids_[codim][item.getIndex()] = createId<codim>(item,macroId,nChild);
-
-      const IdType & itemId = ids_[codim][item.getIndex()];
+      // copy the id, the storage might grow while building the children
+      const IdType itemId = createId<codim>(item,macroId,nChild);
+      setId( codim, item.getIndex() ) = itemId;
 
       buildInteriorElementIds(item,itemId);
     }
@@ -747,8 +777,8 @@ namespace Dune {
     void buildFaceIds(const HFaceType & face, const IdType & fatherId , int innerFace )
     {
       enum { codim = 1 };
-      ids_[codim][face.getIndex()] = createId<codim>(face,fatherId,innerFace);
-      const IdType & faceId = ids_[codim][face.getIndex()];
+      const IdType faceId = createId<codim>(face,fatherId,innerFace);
+      setId( codim, face.getIndex() ) = faceId;
 
       buildInteriorFaceIds(face,faceId);
     }
@@ -791,8 +821,8 @@ namespace Dune {
     void buildEdgeIds(const HEdgeType & edge, const IdType & fatherId , int inneredge)
     {
       enum { codim = 2 };
-      ids_[codim][edge.getIndex()] = createId<codim>(edge,fatherId,inneredge);
-      const IdType & edgeId = ids_[codim][edge.getIndex()];
+      const IdType edgeId = createId<codim>(edge,fatherId,inneredge);
+      setId( codim, edge.getIndex() ) = edgeId;
       buildInteriorEdgeIds(edge,edgeId);
     }
 
@@ -823,8 +853,9 @@ namespace Dune {
     {
       enum { codim = 3 };
       // inner vertex number is 1
-      ids_[codim][vertex.getIndex()] = createId<codim>(vertex,fatherId,1);
-      assert( ids_[codim][vertex.getIndex()].isValid() );
+      const IdType vertexId = createId<codim>(vertex,fatherId,1);
+      assert( vertexId.isValid() );
+      setId( codim, vertex.getIndex() ) = vertexId;
     }
 
     friend class ALU3dGrid< elType, Comm >;
@@ -840,8 +871,7 @@ namespace Dune {
     IdType id (const EntityType & ep) const
     {
       enum { cd = EntityType :: codimension };
-      assert( ids_[cd].find( hset_.index(ep) ) != ids_[cd].end() );
-      const IdType & macroId = ids_[cd][hset_.index(ep)];
+      const IdType & macroId = storedId( cd, hset_.index(ep) );
       assert( macroId.isValid() );
       return getId(macroId);
     }
@@ -850,8 +880,7 @@ namespace Dune {
     template <int codim>
     IdType id (const typename GridType:: template Codim<codim> :: Entity & ep) const
     {
-      assert( ids_[codim].find( hset_.index(ep) ) != ids_[codim].end() );
-      const IdType & macroId = ids_[codim][hset_.index(ep)];
+      const IdType & macroId = storedId( codim, hset_.index(ep) );
       assert( macroId.isValid() );
       return getId(macroId);
     }
@@ -860,8 +889,7 @@ namespace Dune {
     IdType subId ( const EntityCodim0Type &e, int i, unsigned int codim ) const
     {
       const int hIndex = hset_.subIndex( e, i, codim );
-      assert( ids_[ codim ].find( hIndex ) != ids_[ codim ].end() );
-      const IdType &macroId = ids_[ codim ][ hIndex ];
+      const IdType &macroId = storedId( codim, hIndex );
       assert( macroId.isValid() );
       return getId( macroId );
     }
@@ -879,7 +907,8 @@ namespace Dune {
       {
         const IMPLElementType & elem = static_cast<const IMPLElementType &> (item);
         const HFaceType & face  = *(elem.myhface3(faceNum));
-        const IdType & id = ids[face.getIndex()];
+        // copy the id, the storage might grow while building the children
+        const IdType id = ids[face.getIndex()];
         assert( id.isValid() );
         set.buildInteriorFaceIds(face,id);
       }
@@ -895,7 +924,8 @@ namespace Dune {
       {
         const IMPLElementType & elem = static_cast<const IMPLElementType &> (item);
         const HFaceType & face  = *(elem.myhface4(faceNum));
-        const IdType & id = ids[face.getIndex()];
+        // copy the id, the storage might grow while building the children
+        const IdType id = ids[face.getIndex()];
         assert( id.isValid() );
         set.buildInteriorFaceIds(face,id);
       }
@@ -906,7 +936,8 @@ namespace Dune {
     {
       {
         enum { elCodim = 0 };
-        const IdType & fatherId = ids_[elCodim][item.getIndex()];
+        // copy the id, the storage might grow while building the children
+        const IdType fatherId = storedId( elCodim, item.getIndex() );
         assert( fatherId.isValid() );
         buildInteriorElementIds(item, fatherId );
       }
@@ -922,7 +953,7 @@ namespace Dune {
         enum { edgeCodim = 2 };
         const IMPLElementType & elem = static_cast<const IMPLElementType &> (item);
         const HEdgeType & edge  = *( elem.myhedge1(i));
-        const IdType & id = ids_[edgeCodim][edge.getIndex()];
+        const IdType id = storedId( edgeCodim, edge.getIndex() );
         assert( id.isValid() );
         buildInteriorEdgeIds(edge,id);
       }
@@ -30,7 +30,7 @@ namespace Dune {
   ALU3dGridIntersectionIterator(const FactoryType& factory,
                                 int wLevel) :
     connector_( factory.grid().conformingRefinement(), factory.grid().ghostCellsEnabled() ),
-    geoProvider_(connector_),
+    geoProvider_(connector_, &factory.grid().faceGeometryCache()),
     factory_( factory ),
     item_(0),
     ghost_(0),
@@ -44,7 +44,7 @@ namespace Dune {
                                 HElementType *el,
                                 int wLevel,bool end) :
     connector_( factory.grid().conformingRefinement(), factory.grid().ghostCellsEnabled() ),
-    geoProvider_(connector_),
+    geoProvider_(connector_, &factory.grid().faceGeometryCache()),
     factory_( factory ),
     item_(0),
     ghost_(0),
@@ -138,7 +138,7 @@ namespace Dune {
   inline ALU3dGridIntersectionIterator<GridImp> ::
   ALU3dGridIntersectionIterator(const ALU3dGridIntersectionIterator<GridImp> & org) :
     connector_(org.connector_),
-    geoProvider_(connector_),
+    geoProvider_(connector_, &org.factory_.grid().faceGeometryCache()),
     factory_( org.factory_ ),
     item_(org.item_),
     ghost_(org.ghost_)
@@ -361,7 +361,7 @@ namespace Dune {
   unitOuterNormal(const FieldVector<alu3d_ctype, dim-1>& local) const
   {
     unitOuterNormal_ = this->outerNormal(local);
-    unitOuterNormal_ *= (1.0/unitOuterNormal_.two_norm());
+    unitOuterNormal_ *= (1.0/geoProvider_.integrationElement(unitOuterNormal_));
     return unitOuterNormal_;
   }
 
@@ -3,13 +3,32 @@
 #ifndef DUNE_ALUGRID_LBDATAHANDLE_HH
 #define DUNE_ALUGRID_LBDATAHANDLE_HH
 
+#include <cstddef>
+
+#include <dune/common/exceptions.hh>
+
 #include <dune/grid/alugrid/3d/datahandle.hh>
 
+#include <dune/grid/common/adaptationstatistics.hh>
 #include <dune/grid/common/datahandleif.hh>
 
 namespace Dune
 {
 
+  /** \brief wrapper migrating the data of a CommDataHandleIF during load balancing
+   *
+   *  ALUGrid migrates whole macro elements and calls inlineData (xtractData)
+   *  for each of them. Before packing, the size of the data of the macro
+   *  element and all its descendants is computed, so that the space in the
+   *  message buffer is reserved only once. The data is then written without
+   *  further length checks. A data handle writing (reading) a different
+   *  number of data items than given by its size() method causes an
+   *  exception before the reserved space is exceeded.
+   *
+   *  The number of migrated elements, the migrated data volume and the
+   *  time spent packing and unpacking are recorded in the grid's
+   *  AdaptationStatistics.
+   */
   template< class Grid, class DataHandleImpl, class Data >
   class ALUGridLoadBalanceDataHandle
   {
@@ -33,39 +52,78 @@ namespace Dune
     typedef typename Codim< 0 > :: Entity Element;
 
   private:
+    typedef ALU3DSPACE ReservedObjectStream< ObjectStream, Data > ReservedStream;
+
     const Grid &grid_;
     DataHandle &dataHandle_;
+    AdaptationStatistics &statistics_;
 
   public:
-    ALUGridLoadBalanceDataHandle ( const Grid &grid, DataHandle &dataHandle )
+    ALUGridLoadBalanceDataHandle ( Grid &grid, DataHandle &dataHandle )
       : grid_( grid ),
-        dataHandle_( dataHandle )
+        dataHandle_( dataHandle ),
+        statistics_( grid.adaptationStatistics() )
     {}
 
     void inlineData ( ObjectStream &stream, const Element &element ) const
     {
-      inlineElementData( stream, element );
+      AdaptationStatistics::Timer timer( statistics_.packTime );
 
       const int maxLevel = grid_.maxLevel();
       const HierarchicIterator end = element.hend( maxLevel );
+
+      // compute the size of the data of the whole tree and reserve it at once
+      std::size_t elements = 1;
+      std::size_t bytes = elementDataSize( element );
+      for( HierarchicIterator it = element.hbegin( maxLevel ); it != end; ++it, ++elements )
+        bytes += elementDataSize( *it );
+      const std::size_t start = stream.size();
+      stream.reserve( start + bytes );
+
+      inlineElementData( stream, element );
       for( HierarchicIterator it = element.hbegin( maxLevel ); it != end; ++it )
         inlineElementData( stream, *it );
+
+      // exactly the reserved space has to be written
+      if( std::size_t( stream.size() ) != start + bytes )
+        DUNE_THROW( InvalidStateException, "ALUGridLoadBalanceDataHandle: " << (stream.size() - start)
+                                           << " bytes written, but " << bytes << " bytes reserved." );
+
+      AdaptationStatistics::count( statistics_.sentElements, elements );
+      AdaptationStatistics::count( statistics_.sentBytes, bytes );
     }
 
     void xtractData ( ObjectStream &stream, const Element &element, size_t newElements )
     {
-      xtractElementData( stream, element );
+      AdaptationStatistics::Timer timer( statistics_.unpackTime );
+
+      std::size_t bytes = xtractElementData( stream, element );
 
       const int maxLevel = grid_.maxLevel();
       const HierarchicIterator end = element.hend( maxLevel );
       for( HierarchicIterator it = element.hbegin( maxLevel ); it != end; ++it )
-        xtractElementData( stream, *it );
+        bytes += xtractElementData( stream, *it );
+
+      AdaptationStatistics::count( statistics_.receivedElements, newElements );
+      AdaptationStatistics::count( statistics_.receivedBytes, bytes );
     }
 
     void compress ()
     {}
 
   private:
+    std::size_t elementDataSize ( const Element &element ) const
+    {
+      std::size_t bytes = 0;
+      if( dataHandle_.contains( dimension, 0 ) )
+        bytes += entityDataSize< 0 >( element );
+
+      bytes += codimDataSize< 1 >( element );
+      bytes += codimDataSize< 2 >( element );
+      bytes += codimDataSize< 3 >( element );
+      return bytes;
+    }
+
     void inlineElementData ( ObjectStream &stream, const Element &element ) const
     {
       // call element data direct without creating entity pointer
@@ -80,18 +138,39 @@ namespace Dune
       inlineCodimData< 3 >( stream, element );
     }
 
-    void xtractElementData ( ObjectStream &stream, const Element &element )
+    std::size_t xtractElementData ( ObjectStream &stream, const Element &element )
     {
+      std::size_t bytes = 0;
+
       // call element data direct without creating entity pointer
       if( dataHandle_.contains( dimension, 0 ) )
       {
-        xtractEntityData<0>( stream, element );
+        bytes += xtractEntityData<0>( stream, element );
       }
 
       // now call all higher codims
-      xtractCodimData< 1 >( stream, element );
-      xtractCodimData< 2 >( stream, element );
-      xtractCodimData< 3 >( stream, element );
+      bytes += xtractCodimData< 1 >( stream, element );
+      bytes += xtractCodimData< 2 >( stream, element );
+      bytes += xtractCodimData< 3 >( stream, element );
+      return bytes;
+    }
+
+    template< int codim >
+    std::size_t codimDataSize ( const Element &element ) const
+    {
+      typedef typename Codim< codim > :: EntityPointer EntityPointer;
+
+      std::size_t bytes = 0;
+      if( dataHandle_.contains( dimension, codim ) )
+      {
+        const int numSubEntities = element.template count< codim >();
+        for( int i = 0; i < numSubEntities; ++i )
+        {
+          const EntityPointer pEntity = element.template subEntity< codim >( i );
+          bytes += entityDataSize< codim >( *pEntity );
+        }
+      }
+      return bytes;
     }
 
     template< int codim >
@@ -111,37 +190,62 @@ namespace Dune
     }
 
     template< int codim >
-    void xtractCodimData ( ObjectStream &stream, const Element &element )
+    std::size_t xtractCodimData ( ObjectStream &stream, const Element &element )
     {
       typedef typename Codim< codim > :: EntityPointer EntityPointer;
 
+      std::size_t bytes = 0;
       if( dataHandle_.contains( dimension, codim ) )
       {
         const int numSubEntities = element.template count< codim >();
         for( int i = 0; i < numSubEntities; ++i )
         {
           const EntityPointer pEntity = element.template subEntity< codim >( i );
-          xtractEntityData< codim >( stream, *pEntity );
+          bytes += xtractEntityData< codim >( stream, *pEntity );
         }
       }
+      return bytes;
+    }
+
+    // size of the data of one entity in the message buffer (including its size)
+    static std::size_t dataSize ( std::size_t size )
+    {
+      return sizeof( std::size_t ) + size * sizeof( Data );
+    }
+
+    template< int codim >
+    std::size_t entityDataSize ( const typename Codim< codim > :: Entity &entity ) const
+    {
+      return dataSize( dataHandle_.size( entity ) );
     }
 
     template< int codim >
     void inlineEntityData ( ObjectStream &stream,
                             const typename Codim< codim > :: Entity &entity ) const
     {
-      const size_t size = dataHandle_.size( entity );
-      stream.write( size );
-      dataHandle_.gather( stream, entity );
+      // space has been reserved in inlineData; the buffer refuses to write
+      // more than size data items
+      const std::size_t size = dataHandle_.size( entity );
+      stream.writeT( size, false );
+      ReservedStream buffer( stream, size );
+      dataHandle_.gather( buffer, entity );
+      if( buffer.remaining() > 0 )
+        DUNE_THROW( InvalidStateException, "ALUGridLoadBalanceDataHandle: data handle writes "
+                    << (size - buffer.remaining()) << " data items, but size() returns " << size << "." );
     }
 
     template< int codim >
-    void xtractEntityData ( ObjectStream &stream,
-                            const typename Codim< codim > :: Entity &entity )
+    std::size_t xtractEntityData ( ObjectStream &stream,
+                                   const typename Codim< codim > :: Entity &entity )
     {
-      size_t size = 0;
+      std::size_t size = 0;
       stream.read( size );
-      dataHandle_.scatter( stream, entity, size );
+      ReservedStream buffer( stream, size );
+      dataHandle_.scatter( buffer, entity, size );
+      if( buffer.remaining() > 0 )
+        DUNE_THROW( InvalidStateException, "ALUGridLoadBalanceDataHandle: data handle reads "
+                    << (size - buffer.remaining()) << " of " << size << " data items." );
+      return dataSize( size );
     }
   };
 
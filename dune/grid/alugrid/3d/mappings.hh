@@ -51,6 +51,7 @@ namespace Dune {
     void linear (const alu3d_ctype, const alu3d_ctype, const alu3d_ctype) ;
     void linear (const coord_t&) ;
     void inverse (const coord_t&) ;
+    void determinant () ;
   public:
     TrilinearMapping (const coord_t&, const coord_t&,
                       const coord_t&, const coord_t&,
@@ -78,6 +79,7 @@ namespace Dune {
                       const vector_t&, const vector_t&);
 
     // returns true if mapping is affine
+    // (then the derivatives are computed once in buildMapping and world2map needs no Newton iteration)
     inline bool affine () const { return affine_; }
   };
 
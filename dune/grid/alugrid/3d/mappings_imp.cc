@@ -62,13 +62,36 @@ namespace Dune {
         }
       }
 
-      // mapping is affine when all higher terms are zero
-      affine_ = (sum < _epsilon);
+      // sum all factors from linear terms (size of the hexahedron)
+      alu3d_ctype scale = 0.0;
+      for(int i=1; i<4; ++i)
+      {
+        for(int j=0; j<3; ++j)
+        {
+          scale += std::abs(a[i][j]);
+        }
+      }
+
+      // mapping is affine when all higher terms are zero relative to the size
+      // (a degenerate mapping of zero size is not, so det() still checks it)
+      affine_ = (scale > 0) && (sum <= _epsilon * scale);
     }
 
     // initialize flags
     calcedDet_ = calcedLinear_ = calcedInv_ = false;
 
+    // the derivatives of an affine mapping are constant: compute them once
+    if( affine_ )
+    {
+      linear( 0.0, 0.0, 0.0 );
+      determinant();
+      if( DetDf > 0 )
+      {
+        calcedDet_ = true;
+        inverse( coord_t( 0.0 ) );
+      }
+    }
+
     return ;
   }
 
@@ -81,6 +104,17 @@ namespace Dune {
     // copy flags
     affine_ = map.affine_;
     calcedDet_ = calcedLinear_ = calcedInv_ = false;
+
+    // copy the constant derivatives of an affine mapping
+    if( affine_ )
+    {
+      Df = map.Df;
+      Dfi = map.Dfi;
+      DetDf = map.DetDf;
+      calcedLinear_ = map.calcedLinear_;
+      calcedDet_ = map.calcedDet_;
+      calcedInv_ = map.calcedInv_;
+    }
     return ;
   }
 
@@ -173,7 +207,18 @@ namespace Dune {
 
     //  Determinante der Abbildung f:[-1,1]^3 -> Hexaeder im Punkt point.
     linear (point) ;
+    determinant () ;
 
+    assert( DetDf > 0 );
+    //: ( std::cout << "DetDf wrong: " << DetDf << std::endl,false ) );
+
+    // set calced det to affine (true if affine false otherwise)
+    calcedDet_ = affine_ ;
+    return DetDf;
+  }
+
+  alu_inline void TrilinearMapping :: determinant()
+  {
     // code generated by maple
     const alu3d_ctype t4  = Df[0][0] * Df[1][1];
     const alu3d_ctype t6  = Df[0][0] * Df[1][2];
@@ -185,13 +230,6 @@ namespace Dune {
     // determinant
     DetDf = (t4*Df[2][2]-t6*Df[2][1]-t8*Df[2][2]+
              t10*Df[2][1]+t12*Df[1][2]-t14*Df[1][1]);
-
-    assert( DetDf > 0 );
-    //: ( std::cout << "DetDf wrong: " << DetDf << std::endl,false ) );
-
-    // set calced det to affine (true if affine false otherwise)
-    calcedDet_ = affine_ ;
-    return DetDf;
   }
 
   alu_inline void TrilinearMapping :: inverse(const coord_t& point)
@@ -220,6 +258,20 @@ namespace Dune {
 
   alu_inline void TrilinearMapping::world2map (const coord_t& wld , coord_t& map )
   {
+    // affine mapping: one Newton step starting from the origin is exact
+    if( calcedInv_ )
+    {
+      const alu3d_ctype u0 = wld [0] - a [0][0] ;
+      const alu3d_ctype u1 = wld [1] - a [0][1] ;
+      const alu3d_ctype u2 = wld [2] - a [0][2] ;
+
+      // jacobian is stored as transposed
+      map [0] = Dfi [0][0] * u0 + Dfi [1][0] * u1 + Dfi [2][0] * u2 ;
+      map [1] = Dfi [0][1] * u0 + Dfi [1][1] * u1 + Dfi [2][1] * u2 ;
+      map [2] = Dfi [0][2] * u0 + Dfi [1][2] * u1 + Dfi [2][2] * u2 ;
+      return ;
+    }
+
     //  Newton - Iteration zum Invertieren der Abbildung f.
     double err = 10.0 * _epsilon ;
 #ifndef NDEBUG
@@ -50,5 +50,22 @@ namespace Dune {
   //! Tagging interface to indicate that Grid has HierarchicIndexSet
   struct HasHierarchicIndexSet {};
 
+  /** \brief Tagging interface to indicate that a communication data handle
+   *         provides batch gather and scatter methods
+   *
+   *  ALUGrid passes all data of one entity in one contiguous array to such
+   *  data handles, instead of writing (reading) the data items one by one:
+   *  \code
+   *  // fill data with the size( entity ) data items of entity
+   *  template< class Entity >
+   *  void gatherBatch ( const Entity &entity, DataType *data ) const;
+   *
+   *  // read n data items of entity from data
+   *  template< class Entity >
+   *  void scatterBatch ( const Entity &entity, const DataType *data, size_t n );
+   *  \endcode
+   */
+  struct HasBatchGatherScatter {};
+
 } // end namespace Dune
 #endif
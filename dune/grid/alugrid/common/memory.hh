@@ -3,8 +3,10 @@
 #ifndef DUNE_ALU3DGRIDMEMORY_HH
 #define DUNE_ALU3DGRIDMEMORY_HH
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <iostream>
 #include <vector>
 
 namespace ALUGridSpace
@@ -15,6 +17,52 @@ namespace ALUGridSpace
 
 namespace Dune {
 
+  //! usage statistics of an ALUMemoryProvider
+  struct ALUMemoryProviderStatistics
+  {
+    ALUMemoryProviderStatistics ()
+      : allocations( 0 ), reuses( 0 ), deletions( 0 ), objects( 0 ), peakObjects( 0 )
+    {}
+
+    /** \brief add statistics of another provider (e.g., of another thread)
+     *
+     *  \note The peaks of different providers need not occur at the same
+     *        time, so the summed peakObjects is only an upper bound for the
+     *        number of objects handed out at the same time.
+     */
+    ALUMemoryProviderStatistics &operator+= ( const ALUMemoryProviderStatistics &other )
+    {
+      allocations += other.allocations;
+      reuses += other.reuses;
+      deletions += other.deletions;
+      objects += other.objects;
+      peakObjects += other.peakObjects;
+      return *this;
+    }
+
+    //! print statistics
+    void print ( std::ostream &out ) const
+    {
+      out << "objects allocated: " << allocations << std::endl;
+      out << "allocations saved: " << reuses << std::endl;
+      out << "objects deleted:   " << deletions << std::endl;
+      out << "objects in use:    " << objects << " (peak " << peakObjects << ")" << std::endl;
+    }
+
+    unsigned long allocations; //!< number of objects created by new
+    unsigned long reuses;      //!< number of objects taken from the stack instead
+    unsigned long deletions;   //!< number of freed objects deleted because the stack was full
+    /** \brief number of objects currently handed out
+     *
+     *  Objects handed out by one provider may be freed by another one
+     *  (e.g., of another thread). Hence, this number may become negative for
+     *  a single provider; only the sum over all providers is meaningful.
+     */
+    long objects;
+    //! maximal number of objects handed out at the same time (upper bound, if summed)
+    long peakObjects;
+  };
+
   //! organize the memory management for entitys used by the NeighborIterator
   template <class Object>
   class ALUMemoryProvider
@@ -27,17 +75,43 @@ namespace Dune {
 
     StackType& objStack() { return objStack_ ; }
 
+    int capacity_;  // maximal number of objects kept on the stack
+    int stacked_;   // number of objects on the stack
+    ALUMemoryProviderStatistics statistics_;
+
   public:
     typedef Object ObjectType;
 
+    //! maximal number of freed objects kept for reuse
+    static const int maxObjects = maxStackObjects;
+
     //!default constructor
-    ALUMemoryProvider() {}
+    ALUMemoryProvider()
+      : capacity_( maxObjects ), stacked_( 0 )
+    {}
 
     //! do not copy pointers
     ALUMemoryProvider(const ALUMemoryProvider<Object> & org)
-      : objStack_( org.objStack_ )
+      : capacity_( org.capacity_ ), stacked_( 0 )
     {}
 
+    //! limit the number of freed objects kept for reuse (at most maxObjects)
+    void setCapacity ( int capacity )
+    {
+      capacity_ = std::max( 0, std::min( capacity, int( maxObjects ) ) );
+      while( stacked_ > capacity_ )
+      {
+        --stacked_;
+        delete objStack().pop();
+      }
+    }
+
+    //! maximal number of freed objects kept for reuse
+    int capacity () const { return capacity_; }
+
+    //! return usage statistics
+    const ALUMemoryProviderStatistics &statistics () const { return statistics_; }
+
     //! call deleteEntity
     ~ALUMemoryProvider ();
 
@@ -51,7 +125,7 @@ namespace Dune {
     {
       if( objStack().empty() )
       {
-        return ( new ObjectType(EntityImp(factory,level) ));
+        return newObject( new ObjectType(EntityImp(factory,level) ));
       }
       else
       {
@@ -72,10 +146,25 @@ namespace Dune {
     inline ObjectType * stackObject()
     {
       assert( ! objStack().empty() );
+      --stacked_;
+      ++statistics_.reuses;
+      handOut();
       // finite stack does also return object on pop
       return objStack().pop();
     }
 
+    inline ObjectType * newObject( ObjectType * obj )
+    {
+      ++statistics_.allocations;
+      handOut();
+      return obj;
+    }
+
+    inline void handOut ()
+    {
+      statistics_.peakObjects = std::max( statistics_.peakObjects, ++statistics_.objects );
+    }
+
   };
 
 
@@ -91,7 +180,7 @@ namespace Dune {
   {
     if( objStack().empty() )
     {
-      return ( new Object (factory, level) );
+      return newObject( new Object (factory, level) );
     }
     else
     {
@@ -106,7 +195,7 @@ namespace Dune {
   {
     if( objStack().empty() )
     {
-      return ( new Object (org) );
+      return newObject( new Object (org) );
     }
     else
     {
@@ -120,7 +209,7 @@ namespace Dune {
   {
     if( objStack().empty() )
     {
-      return new Object () ;
+      return newObject( new Object () );
     }
     else
     {
@@ -142,13 +231,103 @@ namespace Dune {
   template <class Object>
   inline void ALUMemoryProvider<Object>::freeObject(Object * obj)
   {
+    // objects may be freed by another provider (e.g., of another thread)
+    --statistics_.objects;
     StackType& stk = objStack();
-    if( stk.full() )
+    if( (stacked_ >= capacity_) || stk.full() )
+    {
+      ++statistics_.deletions;
       delete obj;
+    }
     else
+    {
+      ++stacked_;
       stk.push( obj );
+    }
   }
 
+
+  //************************************************************************
+  //
+  //  ALUThreadLocalMemoryProvider
+  //
+  //************************************************************************
+
+  /** \brief one ALUMemoryProvider per thread
+
+      The providers are created on first use by their thread, so that no
+      locking is needed and the stacks of different threads do not share
+      cache lines. Objects may be freed by another thread than the one that
+      requested them; they are then kept on the stack of the freeing thread.
+
+      \tparam  Object      type of the objects provided
+      \tparam  ThreadInfo  class providing static methods threadNumber() and
+                           maxThreads() (e.g., ALUGridObjectFactory)
+
+      \note The number of threads must not exceed ThreadInfo::maxThreads() at
+            the time this object is constructed.
+   */
+  template <class Object, class ThreadInfo>
+  class ALUThreadLocalMemoryProvider
+  {
+    typedef ALUThreadLocalMemoryProvider< Object, ThreadInfo > ThisType;
+
+  public:
+    typedef ALUMemoryProvider< Object > ProviderType;
+
+    explicit ALUThreadLocalMemoryProvider ( int capacity = ProviderType :: maxObjects )
+      : providers_( std::max( ThreadInfo :: maxThreads(), 1 ), (ProviderType *) 0 ),
+        capacity_( capacity )
+    {}
+
+    ~ALUThreadLocalMemoryProvider ()
+    {
+      for( size_t i = 0; i < providers_.size(); ++i )
+        delete providers_[ i ];
+    }
+
+    //! return the provider of the calling thread
+    ProviderType &operator() ()
+    {
+      const int thread = ThreadInfo :: threadNumber();
+      assert( (thread >= 0) && (thread < int( providers_.size() )) );
+      ProviderType *&provider = providers_[ thread ];
+      if( !provider )
+      {
+        provider = new ProviderType();
+        provider->setCapacity( capacity_ );
+      }
+      return *provider;
+    }
+
+    //! limit the number of objects kept per thread (call outside of parallel regions)
+    void setCapacity ( int capacity )
+    {
+      capacity_ = capacity;
+      for( size_t i = 0; i < providers_.size(); ++i )
+        if( providers_[ i ] )
+          providers_[ i ]->setCapacity( capacity_ );
+    }
+
+    //! return usage statistics summed over all threads (call outside of parallel regions)
+    ALUMemoryProviderStatistics statistics () const
+    {
+      ALUMemoryProviderStatistics statistics;
+      for( size_t i = 0; i < providers_.size(); ++i )
+        if( providers_[ i ] )
+          statistics += providers_[ i ]->statistics();
+      return statistics;
+    }
+
+  private:
+    // prohibit copying
+    ALUThreadLocalMemoryProvider ( const ThisType & );
+    ThisType &operator= ( const ThisType & );
+
+    std::vector< ProviderType * > providers_;
+    int capacity_;
+  };
+
 #undef USE_FINITE_STACK
 
 } // end namespace Dune
@@ -0,0 +1,199 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_COMMON_ADAPTATIONSTATISTICS_HH
+#define DUNE_GRID_COMMON_ADAPTATIONSTATISTICS_HH
+
+/** \file
+ *  \brief counters and timers describing the adaptation process of a grid
+ */
+
+#include <cstddef>
+#include <ostream>
+
+#include <dune/common/timer.hh>
+
+namespace Dune
+{
+
+  // AdaptationStatistics
+  // --------------------
+
+  /** \brief counters and timers describing the adaptation process of a grid
+   *
+   *  Grids supporting local adaptation provide an instance of this class via
+   *  adaptationStatistics(). All values are accumulated over the lifetime of
+   *  the grid until reset() is called. Times are given in seconds.
+   *
+   *  Recording is switched off by default, so that production runs do not
+   *  pay for the timers. It is switched on or off for all grids at run time
+   *  by enable(). The layout of this class does not depend on the switch,
+   *  so grids compiled into the library and header-only grids record alike.
+   */
+  struct AdaptationStatistics
+  {
+    class Timer;
+
+    AdaptationStatistics () { reset(); }
+
+    //! return true if statistics are recorded
+    static bool enabled () { return enabledFlag(); }
+
+    //! switch recording of statistics on or off for all grids
+    static void enable ( bool value = true ) { enabledFlag() = value; }
+
+    //! set all counters and timers to zero
+    void reset ()
+    {
+      adaptCalls = 0;
+      markedForRefinement = markedForCoarsening = 0;
+      refined = coarsened = 0;
+      elementDelta = 0;
+      adaptTime = preAdaptTime = postAdaptTime = globalRefineTime = 0.0;
+      indexSetTime = idSetTime = callbackTime = 0.0;
+      loadBalanceCalls = 0;
+      sentElements = receivedElements = 0;
+      sentBytes = receivedBytes = 0;
+      loadBalanceTime = packTime = unpackTime = 0.0;
+    }
+
+    //! add n to a counter
+    static void count ( std::size_t &counter, std::size_t n = 1 )
+    {
+      if( enabled() )
+        counter += n;
+    }
+
+    //! record the change of the number of leaf elements
+    void changeElements ( long before, long after )
+    {
+      if( enabled() )
+        elementDelta += after - before;
+    }
+
+    //! print all counters and timers
+    void print ( std::ostream &out ) const
+    {
+      out << "adapt calls:            " << adaptCalls << std::endl;
+      out << "marked for refinement:  " << markedForRefinement << std::endl;
+      out << "marked for coarsening:  " << markedForCoarsening << std::endl;
+      out << "refined elements:       " << refined << std::endl;
+      out << "coarsened elements:     " << coarsened << std::endl;
+      out << "leaf element delta:     " << elementDelta << std::endl;
+      out << "time in adapt:          " << adaptTime << std::endl;
+      out << "time in preAdapt:       " << preAdaptTime << std::endl;
+      out << "time in postAdapt:      " << postAdaptTime << std::endl;
+      out << "time in globalRefine:   " << globalRefineTime << std::endl;
+      out << "index set update time:  " << indexSetTime << std::endl;
+      out << "id set update time:     " << idSetTime << std::endl;
+      out << "data callback time:     " << callbackTime << std::endl;
+      out << "load balance calls:     " << loadBalanceCalls << std::endl;
+      out << "sent elements:          " << sentElements << std::endl;
+      out << "received elements:      " << receivedElements << std::endl;
+      out << "sent bytes:             " << sentBytes << std::endl;
+      out << "received bytes:         " << receivedBytes << std::endl;
+      out << "time in loadBalance:    " << loadBalanceTime << std::endl;
+      out << "migration pack time:    " << packTime << std::endl;
+      out << "migration unpack time:  " << unpackTime << std::endl;
+    }
+
+    //! number of calls to adapt()
+    std::size_t adaptCalls;
+    //! number of elements marked for refinement
+    std::size_t markedForRefinement;
+    //! number of elements marked for coarsening
+    std::size_t markedForCoarsening;
+    //! number of elements refined
+    std::size_t refined;
+    //! number of elements coarsened (counted as the number of fathers becoming leaf)
+    std::size_t coarsened;
+    /** \brief change of the number of leaf elements
+     *
+     *  The number of leaf elements is the most portable measure for the
+     *  growth of a grid's memory footprint.
+     */
+    long elementDelta;
+
+    //! time spent in adapt()
+    double adaptTime;
+    //! time spent in preAdapt()
+    double preAdaptTime;
+    //! time spent in postAdapt()
+    double postAdaptTime;
+    //! time spent in globalRefine()
+    double globalRefineTime;
+    //! time spent updating index sets (after adaptation or load balancing)
+    double indexSetTime;
+    //! time spent updating id sets (after adaptation or load balancing)
+    double idSetTime;
+    //! time spent in the callbacks of an AdaptDataHandle
+    double callbackTime;
+
+    /** \name Load balancing
+     *
+     *  These values describe the data migration during load balancing with
+     *  a data handle. They are currently only recorded by ALUGrid.
+     *  \{
+     */
+
+    //! number of calls to loadBalance()
+    std::size_t loadBalanceCalls;
+    //! number of elements (including all descendants) sent to other processes
+    std::size_t sentElements;
+    //! number of elements (including all descendants) received from other processes
+    std::size_t receivedElements;
+    //! size of the user data sent to other processes (in bytes)
+    std::size_t sentBytes;
+    //! size of the user data received from other processes (in bytes)
+    std::size_t receivedBytes;
+    //! time spent in loadBalance()
+    double loadBalanceTime;
+    //! time spent packing user data into message buffers
+    double packTime;
+    //! time spent unpacking user data from message buffers
+    double unpackTime;
+
+    /** \} */
+
+  private:
+    static bool &enabledFlag ()
+    {
+      static bool flag = false;
+      return flag;
+    }
+  };
+
+
+
+  // AdaptationStatistics::Timer
+  // ---------------------------
+
+  /** \brief add the lifetime of this object to one of the timers
+   *
+   *  If recording is switched off on construction, the clock is not started
+   *  and the timer is left unchanged.
+   */
+  class AdaptationStatistics::Timer
+  {
+  public:
+    explicit Timer ( double &time )
+      : time_( AdaptationStatistics::enabled() ? &time : 0 ),
+        timer_( time_ != 0 )
+    {}
+
+    ~Timer ()
+    {
+      if( time_ )
+        *time_ += timer_.elapsed();
+    }
+
+  private:
+    Timer ( const Timer & );
+    Timer &operator= ( const Timer & );
+
+    double *time_;
+    Dune::Timer timer_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_COMMON_ADAPTATIONSTATISTICS_HH
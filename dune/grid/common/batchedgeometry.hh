@@ -0,0 +1,208 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_COMMON_BATCHEDGEOMETRY_HH
+#define DUNE_GRID_COMMON_BATCHEDGEOMETRY_HH
+
+/** \file
+ *  \brief axis-aligned cube geometry with batched evaluation
+ */
+
+#include <bitset>
+#include <cstddef>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/axisalignedcubegeometry.hh>
+
+namespace Dune
+{
+
+  // BatchedAxisAlignedCubeGeometry
+  // ------------------------------
+
+  /** \brief axis-aligned cube geometry with batched evaluation
+   *
+   *  Quadrature loops evaluate global() and integrationElement() for many
+   *  points of the same geometry. For axis-aligned cubes these maps are
+   *  trivial, so the per-call overhead dominates. This class adds methods
+   *  evaluating a whole array of points in one call. The loops are arranged
+   *  with the point index innermost, so that the compiler can vectorize them.
+   *  Coordinates can be passed as arrays of FieldVectors or in a
+   *  structure-of-arrays layout.
+   *
+   *  Note that the Jacobians of an axis-aligned cube are constant, so
+   *  jacobianTransposed() and jacobianInverseTransposed() need only be
+   *  evaluated once per geometry.
+   *
+   *  This class is used as implementation base of YaspGeometry and
+   *  SGeometry. For any other axis-aligned geometry, a batched geometry can
+   *  be obtained by batchedAxisAlignedCubeGeometry().
+   */
+  template< class ct, int mydim, int cdim >
+  class BatchedAxisAlignedCubeGeometry
+    : public AxisAlignedCubeGeometry< ct, mydim, cdim >
+  {
+    typedef AxisAlignedCubeGeometry< ct, mydim, cdim > Base;
+
+  public:
+    typedef ct ctype;
+
+    typedef typename Base::LocalCoordinate LocalCoordinate;
+    typedef typename Base::GlobalCoordinate GlobalCoordinate;
+
+    //! constructor for a vertex (mydim = 0)
+    explicit BatchedAxisAlignedCubeGeometry ( const FieldVector< ctype, cdim > &p )
+      : Base( p )
+    {}
+
+    //! constructor for a full-dimensional cube (mydim = cdim)
+    BatchedAxisAlignedCubeGeometry ( const FieldVector< ctype, cdim > &lower, const FieldVector< ctype, cdim > &upper )
+      : Base( lower, upper )
+    {}
+
+    //! constructor for a cube extended in the given axes
+    BatchedAxisAlignedCubeGeometry ( const FieldVector< ctype, cdim > &lower, const FieldVector< ctype, cdim > &upper,
+                                     const std::bitset< cdim > &axes )
+      : Base( lower, upper, axes )
+    {}
+
+    //! construct from an axis-aligned cube geometry
+    explicit BatchedAxisAlignedCubeGeometry ( const Base &base )
+      : Base( base )
+    {}
+
+    using Base::global;
+    using Base::integrationElement;
+
+    /** \brief evaluate global() for an array of points
+     *
+     *  \param[in]   local   array of n local coordinates
+     *  \param[out]  global  array of n global coordinates
+     *  \param[in]   n       number of points
+     */
+    void global ( const LocalCoordinate *local, GlobalCoordinate *global, std::size_t n ) const
+    {
+      GlobalCoordinate lower, extent;
+      int direction[ cdim ];
+      setup( lower, extent, direction );
+
+      for( int k = 0; k < cdim; ++k )
+      {
+        const ctype l = lower[ k ];
+        const int j = direction[ k ];
+        if( j < 0 )
+        {
+          for( std::size_t p = 0; p < n; ++p )
+            global[ p ][ k ] = l;
+        }
+        else
+        {
+          const ctype h = extent[ k ];
+          for( std::size_t p = 0; p < n; ++p )
+            global[ p ][ k ] = l + h * local[ p ][ j ];
+        }
+      }
+    }
+
+    /** \brief evaluate global() for an array of points (structure of arrays)
+     *
+     *  The j-th component of the p-th local coordinate is expected in
+     *  local[ j*n + p ], the k-th component of the p-th global coordinate
+     *  is stored in global[ k*n + p ].
+     *
+     *  \param[in]   n       number of points
+     *  \param[in]   local   mydim*n local coordinate components
+     *  \param[out]  global  cdim*n global coordinate components
+     */
+    void global ( std::size_t n, const ctype *local, ctype *global ) const
+    {
+      GlobalCoordinate lower, extent;
+      int direction[ cdim ];
+      setup( lower, extent, direction );
+
+      for( int k = 0; k < cdim; ++k )
+      {
+        const ctype l = lower[ k ];
+        const int j = direction[ k ];
+        ctype *out = global + k*n;
+        if( j < 0 )
+        {
+          for( std::size_t p = 0; p < n; ++p )
+            out[ p ] = l;
+        }
+        else
+        {
+          const ctype h = extent[ k ];
+          const ctype *in = local + j*n;
+          for( std::size_t p = 0; p < n; ++p )
+            out[ p ] = l + h * in[ p ];
+        }
+      }
+    }
+
+    /** \brief evaluate integrationElement() for an array of points
+     *
+     *  \param[in]   local               array of n local coordinates (unused,
+     *                                   the integration element is constant)
+     *  \param[out]  integrationElement  array of n integration elements
+     *  \param[in]   n                   number of points
+     */
+    void integrationElement ( const LocalCoordinate * /* local */, ctype *integrationElement, std::size_t n ) const
+    {
+      const ctype volume = this->volume();
+      for( std::size_t p = 0; p < n; ++p )
+        integrationElement[ p ] = volume;
+    }
+
+  private:
+    // extract lower left corner, extension and local direction of each global direction
+    void setup ( GlobalCoordinate &lower, GlobalCoordinate &extent, int (&direction)[ cdim ] ) const
+    {
+      // the last corner of a cube is the image of (1,...,1)
+      lower = this->corner( 0 );
+      const GlobalCoordinate upper = this->corner( this->corners()-1 );
+
+      int j = 0;
+      for( int k = 0; k < cdim; ++k )
+      {
+        extent[ k ] = upper[ k ] - lower[ k ];
+        const bool extended = (mydim == cdim) || ((mydim > 0) && (extent[ k ] != ctype( 0 )));
+        direction[ k ] = (extended && (j < mydim) ? j++ : -1);
+      }
+    }
+  };
+
+
+
+  // batchedAxisAlignedCubeGeometry
+  // ------------------------------
+
+  /** \brief create a batched geometry from an axis-aligned geometry
+   *
+   *  Only the lower left and upper right corners are evaluated, so this is
+   *  cheap. The result is only meaningful if the given geometry is an
+   *  axis-aligned cube, e.g., a geometry of YaspGrid, SGrid or OneDGrid.
+   *
+   *  \param[in]  geometry  axis-aligned geometry to convert
+   */
+  template< class Geometry >
+  inline BatchedAxisAlignedCubeGeometry< typename Geometry::ctype, Geometry::mydimension, Geometry::coorddimension >
+  batchedAxisAlignedCubeGeometry ( const Geometry &geometry )
+  {
+    typedef typename Geometry::ctype ctype;
+    const int mydim = Geometry::mydimension;
+    const int cdim = Geometry::coorddimension;
+    typedef BatchedAxisAlignedCubeGeometry< ctype, mydim, cdim > BatchedGeometry;
+
+    // for vertices, the last corner coincides with the first one
+    const FieldVector< ctype, cdim > lower = geometry.corner( 0 );
+    const FieldVector< ctype, cdim > upper = geometry.corner( geometry.corners()-1 );
+    std::bitset< cdim > axes;
+    for( int k = 0; k < cdim; ++k )
+      axes[ k ] = (mydim == cdim) || (upper[ k ] != lower[ k ]);
+    return BatchedGeometry( lower, upper, axes );
+  }
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_COMMON_BATCHEDGEOMETRY_HH
@@ -3,9 +3,9 @@
 #ifndef DUNE_SIZECACHE_HH
 #define DUNE_SIZECACHE_HH
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
-#include <set>
 
 #include <dune/common/forloop.hh>
 #include <dune/common/exceptions.hh>
@@ -290,6 +290,9 @@ namespace Dune {
     }
 
     // counts entities with given type for given iterator
+    // (subentities are identified by their local id; instead of inserting
+    //  each id into a std::set, all ids are collected in a vector, which is
+    //  sorted afterwards. This avoids one allocation per subentity.)
     template < int codim, class IteratorType >
     int countElementsNoCodim(IteratorType & it, const IteratorType & end, std::vector<int>& typeSizes) const
     {
@@ -299,7 +302,7 @@ namespace Dune {
       typedef ReferenceElement< ctype, dim > ReferenceElementType;
       typedef ReferenceElements< ctype, dim > ReferenceElementContainerType;
 
-      typedef std::set< IdType > CodimIdSetType ;
+      typedef std::vector< IdType > CodimIdSetType ;
 
       typedef typename IteratorType :: Entity ElementType ;
 
@@ -328,8 +331,8 @@ namespace Dune {
           const GeometryType geomType = refElem.type( i, codim );
           // get id of sub entity
           const IdType id = idSet.subId( element, i, codim );
-          // insert id into set
-          typeCount[ gtIndex( geomType ) ].insert( id );
+          // collect id, duplicates are removed below
+          typeCount[ gtIndex( geomType ) ].push_back( id );
         }
       }
 
@@ -337,7 +340,9 @@ namespace Dune {
       int overall = 0;
       for(size_t i=0; i<types; ++i)
       {
-        typeSizes[ i ] = typeCount[ i ].size();
+        CodimIdSetType &ids = typeCount[ i ];
+        std::sort( ids.begin(), ids.end() );
+        typeSizes[ i ] = std::unique( ids.begin(), ids.end() ) - ids.begin();
         overall += typeSizes[ i ];
       }
 
@@ -4,7 +4,10 @@
 #define DUNE_GEOGRID_CACHEDCOORDFUNCTION_HH
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <dune/common/typetraits.hh>
 
@@ -31,6 +34,26 @@ namespace Dune
   namespace GeoGrid
   {
 
+    /** \brief entry of the coordinate cache
+     *
+     *  Besides the mapped coordinate, each entry stores the host coordinate
+     *  it was computed from. This allows detecting entries that have to be
+     *  recomputed after adaptation, even if the persistent container reuses
+     *  storage of removed vertices.
+     */
+    template< class HostCoordinate, class Coordinate >
+    struct CoordCacheEntry
+    {
+      CoordCacheEntry ()
+        : hostCoordinate( 0 ), coordinate( 0 ), valid( false )
+      {}
+
+      HostCoordinate hostCoordinate;
+      Coordinate coordinate;
+      bool valid;
+    };
+
+
     template< class HostGrid, class Coordinate >
     class CoordCache
     {
@@ -40,7 +63,12 @@ namespace Dune
 
       typedef typename HostGrid::template Codim< dimension >::Entity Vertex;
 
-      typedef PersistentContainer< HostGrid, Coordinate > DataCache;
+    public:
+      typedef FieldVector< typename HostGrid::ctype, HostGrid::dimensionworld > HostCoordinate;
+      typedef CoordCacheEntry< HostCoordinate, Coordinate > Entry;
+
+    private:
+      typedef PersistentContainer< HostGrid, Entry > DataCache;
 
     public:
       explicit CoordCache ( const HostGrid &hostGrid )
@@ -49,23 +77,35 @@ namespace Dune
 
       template< class Entity >
       const Coordinate &operator() ( const Entity &entity, unsigned int corner ) const
+      {
+        return entry( entity, corner ).coordinate;
+      }
+
+      template< class Entity >
+      Coordinate &operator() ( const Entity &entity, unsigned int corner )
+      {
+        return entry( entity, corner ).coordinate;
+      }
+
+      template< class Entity >
+      const Entry &entry ( const Entity &entity, unsigned int corner ) const
       {
         return data_( entity, corner );
       }
 
-      const Coordinate &operator() ( const Vertex &vertex, unsigned int corner ) const
+      const Entry &entry ( const Vertex &vertex, unsigned int corner ) const
       {
         assert( corner == 0 );
         return data_[ vertex ];
       }
 
       template< class Entity >
-      Coordinate &operator() ( const Entity &entity, unsigned int corner )
+      Entry &entry ( const Entity &entity, unsigned int corner )
       {
-        return data_( entity,corner) ;
+        return data_( entity, corner );
       }
 
-      Coordinate &operator() ( const Vertex &vertex, unsigned int corner )
+      Entry &entry ( const Vertex &vertex, unsigned int corner )
       {
         assert( corner == 0 );
         return data_[ vertex ];
@@ -77,6 +117,11 @@ namespace Dune
         data_.shrinkToFit();
       }
 
+      void invalidate ()
+      {
+        data_.fill( Entry() );
+      }
+
     private:
       CoordCache ( const This & );
       This &operator= ( const This & );
@@ -91,6 +136,21 @@ namespace Dune
   // CachedCoordFunction
   // -------------------
 
+  /** \brief coordinate function caching the mapped coordinates of all host vertices
+   *  \ingroup GeoGrid
+   *
+   *  The cache is built by a traversal of the whole host grid hierarchy. For
+   *  analytical coordinate functions, the traversal only collects the host
+   *  coordinates of vertices missing in the cache and the coordinate function
+   *  is evaluated afterwards in a single loop. If parallel evaluation is
+   *  enabled (see parallelEvaluation()) and the code is compiled with OpenMP
+   *  support, this loop is executed in parallel. In this case the evaluate
+   *  method of the coordinate function must be thread safe. By default, the
+   *  loop is executed serially.
+   *
+   *  After adaptation, only vertices whose host coordinate is unknown to the
+   *  cache are reevaluated (see adapt()).
+   */
   template< class HostGrid, class CoordFunction >
   class CachedCoordFunction
     : public DiscreteCoordFunction< typename CoordFunction::ctype, CoordFunction::dimRange, CachedCoordFunction< HostGrid, CoordFunction > >
@@ -105,25 +165,53 @@ namespace Dune
 
   private:
     typedef GeoGrid::CoordCache< HostGrid, RangeVector > Cache;
+    typedef typename Cache::Entry CacheEntry;
+    typedef typename Cache::HostCoordinate HostCoordinate;
+
+    // pending evaluation of the coordinate function
+    typedef std::vector< std::pair< HostCoordinate, RangeVector * > > Tasks;
 
   public:
     explicit
     CachedCoordFunction ( const HostGrid &hostGrid,
-                          const CoordFunction &coordFunction = CoordFunction() )
+                          const CoordFunction &coordFunction = CoordFunction(),
+                          bool parallelEvaluation = false )
       : hostGrid_( hostGrid ),
         coordFunction_( coordFunction ),
-        cache_( hostGrid )
+        cache_( hostGrid ),
+        parallelEvaluation_( parallelEvaluation )
     {
       buildCache();
     }
 
+    /** \brief enable or disable parallel evaluation of the coordinate function
+     *
+     *  \note Parallel evaluation only takes effect if the code is compiled
+     *        with OpenMP support and requires the evaluate method of the
+     *        (analytical) coordinate function to be thread safe.
+     */
+    void parallelEvaluation ( bool parallel ) { parallelEvaluation_ = parallel; }
+
+    /** \brief is parallel evaluation of the coordinate function enabled? */
+    bool parallelEvaluation () const { return parallelEvaluation_; }
+
+    /** \brief update the cache after adaptation of the host grid
+     *
+     *  Only coordinates of new vertices (i.e., vertices whose host coordinate
+     *  does not match the cached one) are evaluated.
+     */
     void adapt ()
     {
       cache_.adapt();
-      buildCache();
+      updateCache();
     }
 
-    void buildCache ();
+    /** \brief rebuild the entire cache */
+    void buildCache ()
+    {
+      cache_.invalidate();
+      updateCache();
+    }
 
     template< class HostEntity >
     void insertEntity ( const HostEntity &hostEntity );
@@ -144,9 +232,33 @@ namespace Dune
     }
 
   private:
+    void updateCache ();
+
+    template< class HostEntity, class ct, unsigned int dimD, unsigned int dimR, class Impl >
+    void collectEntity ( const HostEntity &hostEntity,
+                         const AnalyticalCoordFunctionInterface< ct, dimD, dimR, Impl > &coordFunction,
+                         Tasks &tasks );
+
+    template< class HostEntity, class ct, unsigned int dimR, class Impl >
+    void collectEntity ( const HostEntity &hostEntity,
+                         const DiscreteCoordFunctionInterface< ct, dimR, Impl > &coordFunction,
+                         Tasks &tasks );
+
+    template< class ct, unsigned int dimD, unsigned int dimR, class Impl >
+    void evaluateTasks ( const AnalyticalCoordFunctionInterface< ct, dimD, dimR, Impl > &coordFunction,
+                         const Tasks &tasks ) const;
+
+    template< class ct, unsigned int dimR, class Impl >
+    void evaluateTasks ( const DiscreteCoordFunctionInterface< ct, dimR, Impl > & /* coordFunction */,
+                         const Tasks &tasks ) const
+    {
+      assert( tasks.empty() );
+    }
+
     const HostGrid &hostGrid_;
     const CoordFunction &coordFunction_;
     Cache cache_;
+    bool parallelEvaluation_;
   };
 
 
@@ -155,7 +267,7 @@ namespace Dune
   // -------------------------------------
 
   template< class HostGrid, class CoordFunction >
-  inline void CachedCoordFunction< HostGrid, CoordFunction >::buildCache ()
+  inline void CachedCoordFunction< HostGrid, CoordFunction >::updateCache ()
   {
     typedef typename HostGrid::template Codim< 0 >::Entity Element;
     typedef typename HostGrid::LevelGridView MacroView;
@@ -166,19 +278,78 @@ namespace Dune
     const MacroView macroView = hostGrid_.levelView( 0 );
     const int maxLevel = hostGrid_.maxLevel();
 
+    // collect all vertices missing in the cache
+    Tasks tasks;
     const MacroIterator mend = macroView.template end< 0, All_Partition >();
     for( MacroIterator mit = macroView.template begin< 0, All_Partition >(); mit != mend; ++mit )
     {
       const Element &macroElement = *mit;
-      insertEntity( macroElement );
+      collectEntity( macroElement, coordFunction_, tasks );
 
       const HierarchicIterator hend = macroElement.hend( maxLevel );
       for( HierarchicIterator hit = macroElement.hbegin( maxLevel ); hit != hend; ++hit )
-        insertEntity( *hit );
+        collectEntity( *hit, coordFunction_, tasks );
+    }
+
+    evaluateTasks( coordFunction_, tasks );
+  }
+
+
+  template< class HostGrid, class CoordFunction >
+  template< class ct, unsigned int dimD, unsigned int dimR, class Impl >
+  inline void CachedCoordFunction< HostGrid, CoordFunction >
+    ::evaluateTasks ( const AnalyticalCoordFunctionInterface< ct, dimD, dimR, Impl > &coordFunction,
+                      const Tasks &tasks ) const
+  {
+    // the tasks are independent, so they can be evaluated in parallel on request
+    const long int numTasks = tasks.size();
+#ifdef _OPENMP
+    const bool parallel = parallelEvaluation_;
+#pragma omp parallel for schedule(static) if( parallel )
+#endif
+    for( long int i = 0; i < numTasks; ++i )
+      coordFunction.evaluate( tasks[ i ].first, *(tasks[ i ].second) );
+  }
+
+
+  template< class HostGrid, class CoordFunction >
+  template< class HostEntity, class ct, unsigned int dimD, unsigned int dimR, class Impl >
+  inline void CachedCoordFunction< HostGrid, CoordFunction >
+    ::collectEntity ( const HostEntity &hostEntity,
+                      const AnalyticalCoordFunctionInterface< ct, dimD, dimR, Impl > & /* coordFunction */,
+                      Tasks &tasks )
+  {
+    const GeoGrid::HostCorners< HostEntity > hostCorners( hostEntity );
+
+    const unsigned int numCorners = hostCorners.size();
+    for( unsigned int i = 0; i < numCorners; ++i )
+    {
+      CacheEntry &entry = cache_.entry( hostEntity, i );
+      const HostCoordinate x = hostCorners[ i ];
+      if( entry.valid && (entry.hostCoordinate == x) )
+        continue;
+
+      // the entry is valid once the task is done, so each vertex is collected only once
+      entry.hostCoordinate = x;
+      entry.valid = true;
+      tasks.push_back( std::make_pair( x, &entry.coordinate ) );
     }
   }
 
 
+  template< class HostGrid, class CoordFunction >
+  template< class HostEntity, class ct, unsigned int dimR, class Impl >
+  inline void CachedCoordFunction< HostGrid, CoordFunction >
+    ::collectEntity ( const HostEntity &hostEntity,
+                      const DiscreteCoordFunctionInterface< ct, dimR, Impl > & /* coordFunction */,
+                      Tasks & /* tasks */ )
+  {
+    // discrete coordinate functions require the host entity for evaluation,
+    // so they are evaluated immediately
+    insertEntity( hostEntity );
+  }
+
+
   template< class HostGrid, class CoordFunction >
   template< class HostEntity >
   inline void CachedCoordFunction< HostGrid, CoordFunction >
@@ -193,7 +364,12 @@ namespace Dune
 
     const unsigned int numCorners = refElement.size( HostEntity::dimension );
     for( unsigned int i = 0; i < numCorners; ++i )
-      coordFunctionCaller.evaluate( i, cache_( hostEntity, i ) );
+    {
+      CacheEntry &entry = cache_.entry( hostEntity, i );
+      coordFunctionCaller.evaluate( i, entry.coordinate );
+      entry.hostCoordinate = hostEntity.geometry().corner( i );
+      entry.valid = true;
+    }
   }
 
 } // namespace Dune
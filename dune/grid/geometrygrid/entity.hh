@@ -214,10 +214,11 @@ namespace Dune
        */
       Geometry geometry () const
       {
-        if( !geo_ )
+        if( !geo_ && !grid().geometryCache().find( hostEntity(), geo_ ) )
         {
           CoordVector coords( hostEntity(), grid().coordFunction() );
           geo_ = GeometryImpl( grid(), type(), coords );
+          grid().geometryCache().insert( hostEntity(), geo_ );
         }
         return Geometry( geo_ );
       }
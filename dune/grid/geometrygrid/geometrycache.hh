@@ -0,0 +1,141 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GEOGRID_GEOMETRYCACHE_HH
+#define DUNE_GEOGRID_GEOMETRYCACHE_HH
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/typetraits.hh>
+
+namespace Dune
+{
+
+  namespace GeoGrid
+  {
+
+    // GeometryCache
+    // -------------
+
+    /** \brief opt-in cache for the geometries of leaf elements
+     *  \ingroup GeoGrid
+     *
+     *  Each call to entity.geometry() on a GeometryGrid evaluates the
+     *  coordinate function in all corners and sets up a new geometry mapping.
+     *  For static grids, repeated sweeps recompute the same mappings over and
+     *  over again. If enabled, this cache keeps the geometry of each leaf
+     *  element, indexed by the host grid's leaf index set. Since geometries
+     *  share their (reference counted) mapping, the corners and, for affine
+     *  mappings, the Jacobians computed once are reused on later sweeps.
+     *
+     *  The cache is filled lazily and cleared whenever the grid is updated,
+     *  e.g., after adaptation or load balancing.
+     *
+     *  \tparam  Grid  GeometryGrid this cache belongs to
+     */
+    template< class Grid >
+    class GeometryCache
+    {
+      typedef GeometryCache< Grid > This;
+
+      typedef typename remove_const< Grid >::type::Traits Traits;
+
+      typedef typename Traits::HostGrid HostGrid;
+
+    public:
+      typedef typename Traits::template Codim< 0 >::GeometryImpl GeometryImpl;
+
+      typedef typename HostGrid::template Codim< 0 >::Entity HostElement;
+
+    private:
+      typedef std::vector< GeometryImpl > GeometryVector;
+
+    public:
+      explicit GeometryCache ( const Grid &grid )
+        : grid_( grid ),
+          enabled_( false )
+      {}
+
+      /** \brief return true if the cache is enabled */
+      bool enabled () const { return enabled_; }
+
+      /** \brief enable or disable the cache
+       *
+       *  \note Disabling the cache releases all cached geometries.
+       */
+      void enable ( bool enabled )
+      {
+        enabled_ = enabled;
+        if( !enabled_ )
+          clear();
+      }
+
+      /** \brief invalidate all cached geometries */
+      void clear ()
+      {
+        GeometryVector().swap( geometries_ );
+      }
+
+      /** \brief look up the geometry of a host entity
+       *
+       *  \param[in]   hostEntity  host entity to look up
+       *  \param[out]  geometry    cached geometry (only set if found)
+       *
+       *  \returns \b true, if a cached geometry was found
+       */
+      template< class HostEntity, class Geometry >
+      bool find ( const HostEntity & /* hostEntity */, Geometry & /* geometry */ ) const
+      {
+        return false;
+      }
+
+      bool find ( const HostElement &hostElement, GeometryImpl &geometry ) const
+      {
+        if( !enabled_ || !hostElement.isLeaf() )
+          return false;
+
+        const std::size_t index = grid_.hostGrid().leafIndexSet().index( hostElement );
+        if( (index >= geometries_.size()) || !geometries_[ index ] )
+          return false;
+
+        geometry = geometries_[ index ];
+        return true;
+      }
+
+      /** \brief insert the geometry of a host entity
+       *
+       *  \param[in]  hostEntity  host entity the geometry belongs to
+       *  \param[in]  geometry    geometry to cache
+       */
+      template< class HostEntity, class Geometry >
+      void insert ( const HostEntity & /* hostEntity */, const Geometry & /* geometry */ )
+      {}
+
+      void insert ( const HostElement &hostElement, const GeometryImpl &geometry )
+      {
+        if( !enabled_ || !hostElement.isLeaf() )
+          return;
+
+        if( geometries_.empty() )
+          geometries_.resize( grid_.hostGrid().leafIndexSet().size( 0 ), GeometryImpl( grid_ ) );
+
+        const std::size_t index = grid_.hostGrid().leafIndexSet().index( hostElement );
+        assert( index < geometries_.size() );
+        geometries_[ index ] = geometry;
+      }
+
+    private:
+      GeometryCache ( const This & );
+      This &operator= ( const This & );
+
+      const Grid &grid_;
+      bool enabled_;
+      GeometryVector geometries_;
+    };
+
+  } // namespace GeoGrid
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GEOGRID_GEOMETRYCACHE_HH
@@ -11,6 +11,7 @@
 #include <dune/grid/geometrygrid/backuprestore.hh>
 #include <dune/grid/geometrygrid/capabilities.hh>
 #include <dune/grid/geometrygrid/datahandle.hh>
+#include <dune/grid/geometrygrid/geometrycache.hh>
 #include <dune/grid/geometrygrid/gridfamily.hh>
 #include <dune/grid/geometrygrid/identity.hh>
 #include <dune/grid/geometrygrid/persistentcontainer.hh>
@@ -239,7 +240,8 @@ namespace Dune
         coordFunction_( coordFunction ),
         removeHostGrid_( false ),
         levelIndexSets_( hostGrid_->maxLevel()+1, nullptr, allocator ),
-        storageAllocator_( allocator )
+        storageAllocator_( allocator ),
+        geometryCache_( *this )
     {}
 
     /** \brief constructor
@@ -256,7 +258,8 @@ namespace Dune
         coordFunction_( *coordFunction ),
         removeHostGrid_( true ),
         levelIndexSets_( hostGrid_->maxLevel()+1, nullptr, allocator ),
-        storageAllocator_( allocator )
+        storageAllocator_( allocator ),
+        geometryCache_( *this )
     {}
 
     /** \brief destructor
@@ -725,6 +728,26 @@ namespace Dune
           delete levelIndexSets_[ i ];
       }
       levelIndexSets_.resize( newNumLevels, nullptr );
+
+      // the host leaf index set might have changed
+      geometryCache_.clear();
+    }
+
+    /** \brief enable or disable caching of element geometries
+     *
+     *  If enabled, the geometries of all leaf elements are kept once they
+     *  have been computed, so that repeated sweeps over a static grid need
+     *  not reevaluate the coordinate function. The cache is invalidated by
+     *  update(), i.e., after adaptation or load balancing.
+     *
+     *  \note The cache is disabled by default. It increases the memory
+     *        footprint by one geometry per leaf element.
+     *
+     *  \param[in]  enable  \b true to enable the cache
+     */
+    void cacheGeometries ( bool enable = true )
+    {
+      geometryCache_.enable( enable );
     }
 
     /** \} */
@@ -754,6 +777,11 @@ namespace Dune
       storageAllocator_.deallocate( (char *)p, size );
     }
 
+    GeoGrid::GeometryCache< const Grid > &geometryCache () const
+    {
+      return geometryCache_;
+    }
+
   private:
     HostGrid *const hostGrid_;
     CoordFunction &coordFunction_;
@@ -763,6 +791,8 @@ namespace Dune
     mutable GlobalIdSet globalIdSet_;
     mutable LocalIdSet localIdSet_;
     mutable typename Allocator::template rebind< char >::other storageAllocator_;
+    // cached geometries use the storage allocator, so this has to be destroyed first
+    mutable GeoGrid::GeometryCache< const Grid > geometryCache_;
   };
 
 
@@ -12,6 +12,7 @@
 #include <dune/grid/common/capabilities.hh>
 #include <dune/grid/common/grid.hh>
 #include <dune/grid/common/gridfactory.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 
 #include <dune/geometry/genericgeometry/topologytypes.hh>
 
@@ -319,6 +320,16 @@ namespace Dune {
     /** \brief Adaptation post-processing: Reset all adaptation state flags */
     void postAdapt();
 
+    /** \brief Obtain counters and timers of the adaptation process */
+    const AdaptationStatistics &adaptationStatistics() const {
+      return adaptationStatistics_;
+    }
+
+    /** \brief Obtain counters and timers of the adaptation process (e.g., to reset them) */
+    AdaptationStatistics &adaptationStatistics() {
+      return adaptationStatistics_;
+    }
+
     // **********************************************************
     // End of Interface Methods
     // **********************************************************
@@ -338,11 +349,27 @@ namespace Dune {
 
     /** \brief Does one uniform refinement step
      *
-     * \param refCount I don't know what this is good for.  It doesn't
-     *        actually do anything.
+     * If all leaf elements are on the top level, the new level is built
+     * directly in one pass over the top level, bypassing mark() and adapt().
+     * Otherwise the general adaptation machinery is used.
+     *
+     * \param refCount Number of refinement steps
      */
     void globalRefine(int refCount);
 
+    /** \brief Relocate all entities into iteration order
+
+       The vertices and elements of each level are moved into contiguous
+       memory in the order of the level lists, so that subsequent grid
+       traversals amount to sequential memory access.  Since adapt() splices
+       new entities into the lists wherever there is free memory, calling
+       this method after adaptation restores the locality of the data.
+
+       Indices and ids are not changed, but all EntityPointers into the grid
+       become invalid, just like after a call to adapt().
+     */
+    void compactStorage();
+
     // dummy parallel functions
 
     template<class DataHandle>
@@ -402,6 +429,27 @@ namespace Dune {
      */
     OneDGridList<OneDEntityImp<1> >::iterator getLeftNeighborWithSon(OneDGridList<OneDEntityImp<1> >::iterator eIt);
 
+    /** \brief Refine all elements of the top level, if these are all the leaf elements
+
+        The new vertices and elements are appended to the new level in one
+        pass, and their indices are set on the fly.
+
+        \return false if there are leaf elements below the top level.  Nothing
+        has been done in that case.
+     */
+    bool uniformRefine();
+
+    /** \brief Append a new empty level to the grid hierarchy */
+    void appendLevel() {
+      entityImps_.push_back(tuple<OneDGridList<OneDEntityImp<0> >, OneDGridList<OneDEntityImp<1> > >(OneDGridList<OneDEntityImp<0> >(&vertexPool_),
+                                                                                                      OneDGridList<OneDEntityImp<1> >(&elementPool_)));
+    }
+
+    // The memory all vertices and elements are allocated from.
+    // These have to outlive the entity lists.
+    OneDGridEntityPool<OneDEntityImp<0> > vertexPool_;
+    OneDGridEntityPool<OneDEntityImp<1> > elementPool_;
+
     // The vertices and elements of the grid hierarchy
     std::vector<tuple<OneDGridList<OneDEntityImp<0> >,
             OneDGridList<OneDEntityImp<1> > > > entityImps_;
@@ -422,6 +470,8 @@ namespace Dune {
         This flag stores which is the case. */
     bool reversedBoundarySegmentNumbering_;
 
+    AdaptationStatistics adaptationStatistics_;
+
   }; // end Class OneDGrid
 
   namespace Capabilities
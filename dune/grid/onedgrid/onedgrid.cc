@@ -29,7 +29,7 @@ Dune::OneDGrid::OneDGrid(int numElements, const ctype& leftBoundary, const ctype
     DUNE_THROW(GridError, "The left boundary coordinate has to be strictly less than the right boundary one!");
 
   // Init grid hierarchy
-  entityImps_.resize(1);
+  appendLevel();
 
   // Init vertex set
   for (int i=0; i<numElements+1; i++) {
@@ -69,7 +69,7 @@ Dune::OneDGrid::OneDGrid(const std::vector<ctype>& coords)
     DUNE_THROW(GridError, "You have to provide at least two coordinates!");
 
   // Init grid hierarchy
-  entityImps_.resize(1);
+  appendLevel();
 
   // Init vertex set
   for (size_t i=0; i<coords.size(); i++) {
@@ -261,6 +261,10 @@ Dune::OneDGrid::getLeftNeighborWithSon(OneDGridList<OneDEntityImp<1> >::iterator
 
 bool Dune::OneDGrid::adapt()
 {
+  AdaptationStatistics::Timer timer(adaptationStatistics_.adaptTime);
+  AdaptationStatistics::count(adaptationStatistics_.adaptCalls);
+  const int oldSize = leafIndexSet_.size(0);
+
   OneDGridList<OneDEntityImp<1> >::iterator eIt;
 
   // for the return value:  true if the grid was changed
@@ -323,6 +327,8 @@ bool Dune::OneDGrid::adapt()
         // Actually delete elements
         elements(i).erase(leftElementToBeDeleted);
         elements(i).erase(rightElementToBeDeleted);
+
+        AdaptationStatistics::count(adaptationStatistics_.coarsened);
       }
 
       // increment pointer
@@ -346,9 +352,7 @@ bool Dune::OneDGrid::adapt()
     }
 
   if (toplevelRefinement) {
-    OneDGridList<OneDEntityImp<0> > newVertices;
-    OneDGridList<OneDEntityImp<1> > newElements;
-    entityImps_.push_back(tuple<OneDGridList<OneDEntityImp<0> >, OneDGridList<OneDEntityImp<1> > >(newVertices, newElements));
+    appendLevel();
   }
 
   // //////////////////////////////
@@ -439,6 +443,8 @@ bool Dune::OneDGrid::adapt()
 
         eIt->sons_[1] = elements(i+1).insert(eIt->sons_[0]->succ_, newElement1);
 
+        AdaptationStatistics::count(adaptationStatistics_.refined);
+
         // The grid has been modified
         refinedGrid = true;
 
@@ -532,13 +538,20 @@ bool Dune::OneDGrid::adapt()
   // ////////////////////////////////////
   //   renumber vertices and elements
   // ////////////////////////////////////
-  setIndices();
+  {
+    AdaptationStatistics::Timer indexSetTimer(adaptationStatistics_.indexSetTime);
+    setIndices();
+  }
+
+  adaptationStatistics_.changeElements(oldSize, leafIndexSet_.size(0));
 
   return refinedGrid;
 }
 
 bool Dune::OneDGrid::preAdapt()
 {
+  AdaptationStatistics::Timer timer(adaptationStatistics_.preAdaptTime);
+
   Codim<0>::LeafIterator eIt    = leafbegin<0>();
   Codim<0>::LeafIterator eEndIt = leafend<0>();
 
@@ -551,6 +564,8 @@ bool Dune::OneDGrid::preAdapt()
 
 void Dune::OneDGrid::postAdapt()
 {
+  AdaptationStatistics::Timer timer(adaptationStatistics_.postAdaptTime);
+
   for (int i=0; i<=maxLevel(); i++) {
     OneDGridList<OneDEntityImp<1> >::iterator eIt;
     for (eIt = elements(i).begin(); eIt!=elements(i).end(); eIt = eIt->succ_)
@@ -589,8 +604,14 @@ void Dune::OneDGrid::setIndices()
 
 void Dune::OneDGrid::globalRefine(int refCount)
 {
+  AdaptationStatistics::Timer timer(adaptationStatistics_.globalRefineTime);
+
   for (int i=0; i<refCount; i++) {
 
+    // take the shortcut if the grid is uniform
+    if (uniformRefine())
+      continue;
+
     // mark all entities for grid refinement
     Codim<0>::LeafIterator iIt    = leafbegin<0>();
     Codim<0>::LeafIterator iEndIt = leafend<0>();
@@ -604,6 +625,151 @@ void Dune::OneDGrid::globalRefine(int refCount)
   }
 }
 
+bool Dune::OneDGrid::uniformRefine()
+{
+  // All leaf elements have to be on the top level
+  for (int i=0; i<maxLevel(); i++) {
+    OneDGridList<OneDEntityImp<1> >::iterator eIt;
+    for (eIt = elements(i).begin(); eIt!=elements(i).end(); eIt = eIt->succ_)
+      if (eIt->isLeaf())
+        return false;
+  }
+
+  const int level = maxLevel();
+  const int numFathers = elements(level).size();
+
+  // Put the new level into contiguous memory.  There are at most
+  // 2n+1 new vertices; fewer if the top level has gaps.
+  vertexPool_.reserve(2*numFathers+1);
+  elementPool_.reserve(2*numFathers);
+
+  appendLevel();
+
+  unsigned int numVertices = 0;
+  unsigned int numElements = 0;
+
+  OneDGridList<OneDEntityImp<1> >::iterator eIt;
+  for (eIt = elements(level).begin(); eIt!=elements(level).end(); eIt = eIt->succ_) {
+
+    // The left vertex already has a son if the left neighbor has just been refined
+    OneDGridList<OneDEntityImp<0> >::iterator leftUpperVertex = eIt->vertex_[0]->son_;
+
+    if (leftUpperVertex==NULL) {
+      leftUpperVertex = vertices(level+1).push_back(OneDEntityImp<0>(level+1, eIt->vertex_[0]->pos_, eIt->vertex_[0]->id_));
+      leftUpperVertex->levelIndex_ = leftUpperVertex->leafIndex_ = numVertices++;
+      eIt->vertex_[0]->son_ = leftUpperVertex;
+    }
+
+    ctype p = 0.5*(eIt->vertex_[0]->pos_[0] + eIt->vertex_[1]->pos_[0]);
+    OneDGridList<OneDEntityImp<0> >::iterator centerVertex
+      = vertices(level+1).push_back(OneDEntityImp<0>(level+1, p, getNextFreeId(1)));
+    centerVertex->levelIndex_ = centerVertex->leafIndex_ = numVertices++;
+
+    // The right vertex cannot have a son yet, because the elements are sorted
+    assert(eIt->vertex_[1]->son_==NULL);
+    OneDGridList<OneDEntityImp<0> >::iterator rightUpperVertex
+      = vertices(level+1).push_back(OneDEntityImp<0>(level+1, eIt->vertex_[1]->pos_, eIt->vertex_[1]->id_));
+    rightUpperVertex->levelIndex_ = rightUpperVertex->leafIndex_ = numVertices++;
+    eIt->vertex_[1]->son_ = rightUpperVertex;
+
+    // Create the two sons
+    OneDEntityImp<1> newElement0(level+1, getNextFreeId(0), reversedBoundarySegmentNumbering_);
+    newElement0.vertex_[0] = leftUpperVertex;
+    newElement0.vertex_[1] = centerVertex;
+    newElement0.father_ = eIt;
+    newElement0.levelIndex_ = newElement0.leafIndex_ = numElements++;
+
+    OneDEntityImp<1> newElement1(level+1, getNextFreeId(0), reversedBoundarySegmentNumbering_);
+    newElement1.vertex_[0] = centerVertex;
+    newElement1.vertex_[1] = rightUpperVertex;
+    newElement1.father_ = eIt;
+    newElement1.levelIndex_ = newElement1.leafIndex_ = numElements++;
+
+    eIt->sons_[0] = elements(level+1).push_back(newElement0);
+    eIt->sons_[1] = elements(level+1).push_back(newElement1);
+  }
+
+  // ///////////////////////////////////////////////////////////////////
+  //   Update the indices.  The level indices of the old levels remain
+  //   valid, and the new level is the leaf level.  Vertices below the
+  //   top level inherit the leaf index of their son.
+  // ///////////////////////////////////////////////////////////////////
+  for (int i=levelIndexSets_.size(); i<maxLevel()+1; i++)
+    levelIndexSets_.push_back( (OneDGridLevelIndexSet< const OneDGrid > *) 0 );
+
+  for (int i=level; i>=0; i--) {
+    OneDGridList<OneDEntityImp<0> >::iterator vIt;
+    for (vIt = vertices(i).begin(); vIt!=vertices(i).end(); vIt = vIt->succ_) {
+      assert(!vIt->isLeaf());
+      vIt->leafIndex_ = vIt->son_->leafIndex_;
+    }
+  }
+
+  leafIndexSet_.setSizesAndTypes(numVertices, numElements);
+
+  AdaptationStatistics::count(adaptationStatistics_.refined, numFathers);
+  adaptationStatistics_.changeElements(numFathers, numElements);
+
+  // Reset the adaptation flags, as postAdapt() would
+  postAdapt();
+
+  return true;
+}
+
+void Dune::OneDGrid::compactStorage()
+{
+  // Reserve one contiguous block for all vertices and one for all elements
+  std::size_t numVertices = 0, numElements = 0;
+  for (int i=0; i<=maxLevel(); i++) {
+    numVertices += vertices(i).size();
+    numElements += elements(i).size();
+  }
+
+  OneDGridEntityPool<OneDEntityImp<0> > newVertexPool;
+  OneDGridEntityPool<OneDEntityImp<1> > newElementPool;
+  newVertexPool.reserve(numVertices);
+  newElementPool.reserve(numElements);
+
+  // Copy all entities level by level.  The pred_ pointer of each old entity
+  // now points to its copy.
+  std::vector<OneDGridList<OneDEntityImp<0> >::iterator> oldVertices(maxLevel()+1);
+  std::vector<OneDGridList<OneDEntityImp<1> >::iterator> oldElements(maxLevel()+1);
+  for (int i=0; i<=maxLevel(); i++) {
+    oldVertices[i] = vertices(i).relocate(newVertexPool);
+    oldElements[i] = elements(i).relocate(newElementPool);
+  }
+
+  // Redirect all pointers between entities to the copies
+  for (int i=0; i<=maxLevel(); i++) {
+
+    OneDGridList<OneDEntityImp<0> >::iterator vIt;
+    for (vIt = vertices(i).begin(); vIt!=vertices(i).end(); vIt = vIt->succ_)
+      if (vIt->son_)
+        vIt->son_ = vIt->son_->pred_;
+
+    OneDGridList<OneDEntityImp<1> >::iterator eIt;
+    for (eIt = elements(i).begin(); eIt!=elements(i).end(); eIt = eIt->succ_) {
+      for (int j=0; j<2; j++) {
+        eIt->vertex_[j] = eIt->vertex_[j]->pred_;
+        if (eIt->sons_[j])
+          eIt->sons_[j] = eIt->sons_[j]->pred_;
+      }
+      if (eIt->father_)
+        eIt->father_ = eIt->father_->pred_;
+    }
+
+  }
+
+  // Destroy the old entities and take over the new memory
+  for (int i=0; i<=maxLevel(); i++) {
+    vertices(i).releaseRelocated(oldVertices[i]);
+    elements(i).releaseRelocated(oldElements[i]);
+  }
+
+  vertexPool_.swap(newVertexPool);
+  elementPool_.swap(newElementPool);
+}
+
 bool Dune::OneDGrid::mark(int refCount,
                           const Codim<0>::Entity & e )
 {
@@ -616,12 +782,14 @@ bool Dune::OneDGrid::mark(int refCount,
       return false;
     else {
       getRealImplementation(e).target_->markState_ = OneDEntityImp<1>::COARSEN;
+      AdaptationStatistics::count(adaptationStatistics_.markedForCoarsening);
       return true;
     }
 
-  } else if (refCount > 0)
+  } else if (refCount > 0) {
     getRealImplementation(e).target_->markState_ = OneDEntityImp<1>::REFINE;
-  else
+    AdaptationStatistics::count(adaptationStatistics_.markedForRefinement);
+  } else
     getRealImplementation(e).target_->markState_ = OneDEntityImp<1>::DO_NOTHING;
 
   return true;
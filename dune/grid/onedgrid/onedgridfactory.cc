@@ -86,7 +86,7 @@ createGrid()
   //   Insert the vertices into the grid
   // ////////////////////////////////////////////////////////
 
-  grid_->entityImps_.resize(1);
+  grid_->appendLevel();
 
 
   VertexIterator vIt    = vertexPositions_.begin();
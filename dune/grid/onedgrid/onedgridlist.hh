@@ -3,6 +3,12 @@
 #ifndef DUNE_ONEDGRID_LIST_HH
 #define DUNE_ONEDGRID_LIST_HH
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <vector>
+
 #include <dune/common/iteratorfacades.hh>
 
 namespace Dune {
@@ -49,6 +55,131 @@ namespace Dune {
     T* pointer_;
   };
 
+  /** \brief Pool allocator for the entities stored in a OneDGridList
+
+      Entities are placed into large blocks of raw memory instead of being
+      allocated one at a time from the heap.  Freed slots are kept on a free
+      list and reused by later allocations, except for allocations reserved
+      by reserve(), which are always served from one contiguous block.  All
+      blocks are released when the pool is destroyed; by then, all entities
+      must have been deallocated.
+   */
+  template<class T>
+  class OneDGridEntityPool
+  {
+    // A free slot stores a pointer to the next free slot
+    struct FreeSlot
+    {
+      FreeSlot* next_;
+    };
+
+    enum { slotSize = (sizeof(T) < sizeof(FreeSlot)) ? sizeof(FreeSlot) : sizeof(T) };
+
+  public:
+    /** \brief Constructor
+        \param chunkSize Number of entities allocated at once when the pool runs empty
+     */
+    explicit OneDGridEntityPool(std::size_t chunkSize = 1024)
+      : chunkSize_(chunkSize), current_(0), remaining_(0), reserved_(0), freeList_(0)
+    {
+      assert(chunkSize_ > 0);
+    }
+
+    ~OneDGridEntityPool() {
+      release();
+    }
+
+    /** \brief Create a new entity by copy construction */
+    T* allocate(const T& value) {
+      void* slot;
+      if (reserved_ > 0) {
+        // reserved allocations bypass the free list to stay contiguous
+        slot = current_;
+        current_ += slotSize;
+        --remaining_;
+        --reserved_;
+      }
+      else if (freeList_ != 0) {
+        slot = freeList_;
+        freeList_ = freeList_->next_;
+      }
+      else {
+        if (remaining_ == 0)
+          newBlock(chunkSize_);
+        slot = current_;
+        current_ += slotSize;
+        --remaining_;
+      }
+      return new (slot) T(value);
+    }
+
+    /** \brief Destroy an entity and put its slot onto the free list */
+    void deallocate(T* t) {
+      t->~T();
+      FreeSlot* slot = reinterpret_cast<FreeSlot*>(t);
+      slot->next_ = freeList_;
+      freeList_ = slot;
+    }
+
+    /** \brief Make sure that the next n allocations are served from one contiguous block
+
+        The reserved allocations are taken from the current block even if the
+        free list is not empty.  Slots on the free list (including the rest of
+        a block abandoned by this method) are only reused afterwards.
+     */
+    void reserve(std::size_t n) {
+      if (remaining_ < n)
+        newBlock(n < chunkSize_ ? chunkSize_ : n);
+      reserved_ = n;
+    }
+
+    /** \brief Exchange the memory of two pools */
+    void swap(OneDGridEntityPool& other) {
+      std::swap(chunkSize_, other.chunkSize_);
+      blocks_.swap(other.blocks_);
+      std::swap(current_, other.current_);
+      std::swap(remaining_, other.remaining_);
+      std::swap(reserved_, other.reserved_);
+      std::swap(freeList_, other.freeList_);
+    }
+
+  private:
+    // Pools own raw memory and are not copyable
+    OneDGridEntityPool(const OneDGridEntityPool&);
+    OneDGridEntityPool& operator=(const OneDGridEntityPool&);
+
+    void newBlock(std::size_t n) {
+      // Put the rest of the current block onto the free list, so nothing gets lost
+      for (; remaining_ > 0; --remaining_, current_ += slotSize) {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(current_);
+        slot->next_ = freeList_;
+        freeList_ = slot;
+      }
+
+      current_ = static_cast<char*>(::operator new(n*slotSize));
+      blocks_.push_back(current_);
+      remaining_ = n;
+    }
+
+    void release() {
+      for (std::size_t i=0; i<blocks_.size(); i++)
+        ::operator delete(blocks_[i]);
+      blocks_.clear();
+      current_ = 0;
+      remaining_ = 0;
+      reserved_ = 0;
+      freeList_ = 0;
+    }
+
+    std::size_t chunkSize_;
+    std::vector<char*> blocks_;
+    char* current_;
+    std::size_t remaining_;
+    // number of upcoming allocations to be served from the current block
+    std::size_t reserved_;
+    FreeSlot* freeList_;
+  };
+
   template<class T>
   class OneDGridList
   {
@@ -57,7 +188,14 @@ namespace Dune {
     typedef T* iterator;
     typedef const T* const_iterator;
 
-    OneDGridList() : numelements(0), begin_(0), rbegin_(0) {}
+    /** \brief The type of the pool the list elements may be allocated from */
+    typedef OneDGridEntityPool<T> Pool;
+
+    /** \brief Constructor
+        \param pool Pool to allocate the list elements from.  If no pool is
+        given, each element is allocated separately on the heap.
+     */
+    explicit OneDGridList(Pool* pool = 0) : numelements(0), begin_(0), rbegin_(0), pool_(pool) {}
 
     int size() const {return numelements;}
 
@@ -66,7 +204,7 @@ namespace Dune {
       T* i = rbegin();
 
       // New list element by copy construction
-      T* t = new T(value);
+      T* t = allocate(value);
 
       // einfuegen
       if (begin_==0) {
@@ -101,7 +239,7 @@ namespace Dune {
         return push_back(value);
 
       // New list element by copy construction
-      T* t = new T(value);
+      T* t = allocate(value);
 
       // insert
       if (begin_==0)
@@ -151,7 +289,46 @@ namespace Dune {
       numelements = numelements-1;
 
       // Actually delete the object
-      delete(i);
+      deallocate(i);
+    }
+
+    /** \brief Move all list elements into consecutive slots of a new pool
+
+        The elements are copied in list order, so that traversing the list
+        afterwards amounts to sequential memory access if the pool was
+        reserved beforehand.  The pred_ and succ_ pointers of the copies are
+        set up for the new list.  The old elements stay in place, but their
+        pred_ pointers are overwritten by the address of their copies.  This
+        allows to redirect all other pointers into the list, before the old
+        elements are destroyed by releaseRelocated().
+
+        \return Head of the chain of old elements, still linked by succ_
+     */
+    iterator relocate(Pool& pool) {
+      T* oldBegin = begin_;
+      T* newPred = 0;
+      for (T* old = begin_; old != 0; old = old->succ_) {
+        T* t = pool.allocate(*old);
+        t->pred_ = newPred;
+        t->succ_ = 0;
+        if (newPred != 0)
+          newPred->succ_ = t;
+        else
+          begin_ = t;
+        old->pred_ = t;
+        newPred = t;
+      }
+      rbegin_ = newPred;
+      return oldBegin;
+    }
+
+    /** \brief Destroy the old elements left behind by relocate() */
+    void releaseRelocated(iterator oldBegin) {
+      while (oldBegin != 0) {
+        T* succ = oldBegin->succ_;
+        deallocate(oldBegin);
+        oldBegin = succ;
+      }
     }
 
     iterator begin() {
@@ -180,11 +357,24 @@ namespace Dune {
 
   private:
 
+    T* allocate(const T& value) {
+      return (pool_ != 0) ? pool_->allocate(value) : new T(value);
+    }
+
+    void deallocate(T* t) {
+      if (pool_ != 0)
+        pool_->deallocate(t);
+      else
+        delete t;
+    }
+
     int numelements;
 
     T* begin_;
     T* rbegin_;
 
+    Pool* pool_;
+
   };   // end class OneDGridList
 
 } // namespace Dune
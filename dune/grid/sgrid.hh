@@ -14,6 +14,7 @@
 #include <dune/common/reservedvector.hh>
 #include <dune/geometry/genericgeometry/topologytypes.hh>
 #include <dune/geometry/axisalignedcubegeometry.hh>
+#include <dune/grid/common/batchedgeometry.hh>
 #include <dune/grid/common/capabilities.hh>
 #include <dune/grid/common/grid.hh>
 #include <dune/grid/sgrid/numbering.hh>
@@ -99,10 +100,13 @@ namespace Dune {
      \f[(s,r^k) + \sum\limits_{i=0}^{d-1} l_i (r^i,r^k) = (p,r^k) \ \ \ \forall k=0,\ldots,d-1. \f]
 
      The resulting system is diagonal since the direction vectors are required to be orthogonal.
+
+     Being derived from BatchedAxisAlignedCubeGeometry, SGeometry also provides batched
+     evaluation of global() and integrationElement() for arrays of local coordinates.
    */
   template<int mydim, int cdim, class GridImp>
   class SGeometry
-    : public AxisAlignedCubeGeometry<typename GridImp::ctype,mydim,cdim>
+    : public BatchedAxisAlignedCubeGeometry<typename GridImp::ctype,mydim,cdim>
   {
   public:
     //! define type used for coordinates in grid module
@@ -142,7 +146,7 @@ namespace Dune {
 
     //! constructor
     SGeometry ()
-      : AxisAlignedCubeGeometry<ctype,mydim,cdim>(FieldVector<ctype,cdim>(0),FieldVector<ctype,cdim>(0))    // anything
+      : BatchedAxisAlignedCubeGeometry<ctype,mydim,cdim>(FieldVector<ctype,cdim>(0),FieldVector<ctype,cdim>(0))    // anything
     {}
   };
 
@@ -381,7 +385,7 @@ namespace Dune {
     {
       if (codim==0) return this->compressedIndex();
       // compute subIndex
-      return (this->grid)->n(this->l, this->grid->subz(this->z,i,codim));
+      return this->grid->subn(this->l, this->z, i, codim);
     }
 
     /*! subentity leaf index
@@ -393,7 +397,7 @@ namespace Dune {
 
       assert(this->l == this->grid->maxLevel());
       // compute subIndex
-      return (this->grid)->n(this->l, this->grid->subz(this->z,i,codim));
+      return this->grid->subn(this->l, this->z, i, codim);
     }
 
     //! subentity persistent index
@@ -1575,6 +1579,9 @@ namespace Dune {
     //! compute zentity of subentity of given codim
     array<int,dim> subz (const array<int,dim> & z, int i, int codim) const;
 
+    //! compute number of subentity of given codim from the expanded coordinate of an element
+    int subn (int level, const array<int,dim> & z, int i, int codim) const;
+
     //! compress from expanded coordinates to grid for a single partition number
     array<int,dim> compress (int level, const array<int,dim>& z) const;
 
@@ -1689,6 +1696,10 @@ namespace Dune {
     std::vector<FieldVector<ctype, dim> > h;   // mesh size per direction for each level
     mutable CubeMapper<dim> *mapper; // a mapper for each level
 
+    // subentities of an element: offset of the expanded coordinate and partition number
+    std::vector<array<int,dim> > subshift[dim+1];
+    std::vector<int> subpartition[dim+1];
+
     // boundary segement index set
     array<CubeMapper<dim-1>, dim> boundarymapper; // a mapper for each coarse grid face
     int boundarysize;
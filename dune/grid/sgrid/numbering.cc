@@ -131,7 +131,12 @@ namespace Dune {
       lex[b].init(t);           // set up lex ordering of tupels
       nb[b] = lex[b].tupels();
       cb[b] = ones(b);
+      offset[b] = ne[cb[b]];    // partitions of a codimension are joined in ascending order
       ne[cb[b]] += nb[b];
+
+      stride[b][0] = 1;
+      for (int i=1; i<dim; i++)
+        stride[b][i] = stride[b][i-1]*t[i-1];
     }
 
     // preprocess lex ordering for each codimension
@@ -187,18 +192,25 @@ namespace Dune {
   template<int dim>
   inline int CubeMapper<dim>::n (const array<int,dim>& z) const
   {
-    int p = partition(z);            // get partition
-    array<int,dim> r=compress(z);     // get compressd coordinate
+    // get partition: bit i is set if z[i] is even
+    int p = 0;
+    for (int i=0; i<dim; i++)
+      p |= ((~z[i])&1)<<i;
 
-    // treat easy cases first
-    if (p==0 || p==power2(dim)-1)
-    {
-      // all components are either odd or even
-      return lex[p].n(r);
-    }
+    // z[i]>>1 is the compressed coordinate for both, even and odd components
+    int r = offset[p];
+    for (int i=0; i<dim; i++)
+      r += (z[i]>>1)*stride[p][i];
+    return r;
+  }
 
-    // general case
-    return join[ones(p)].n(p,lex[p].n(r));
+  template<int dim>
+  inline int CubeMapper<dim>::n (int b, const array<int,dim>& r) const
+  {
+    int k = offset[b];
+    for (int i=0; i<dim; i++)
+      k += r[i]*stride[b][i];
+    return k;
   }
 
   template<int dim>
@@ -96,10 +96,15 @@ namespace Dune {
     int codim (const array<int,dim>& z) const;
 
     /*! compute number from coordinate 0 <= n < elements(codim(z))
-         general implementation is O(2^dim)
+         O(dim) using the precomputed strides of the partition of z
      */
     int n (const array<int,dim>& z) const;
 
+    /*! compute number from partition number and compressed coordinate
+         O(dim) using the precomputed strides of the partition
+     */
+    int n (int b, const array<int,dim>& r) const;
+
     //! compute coordinates from number and codimension
     array<int,dim> z (int i, int codim) const;
 
@@ -122,6 +127,8 @@ namespace Dune {
     int cb[1<<dim];       // codimension of binary partition
     LexOrder<dim> lex[1<<dim];         // lex ordering within binary partition
     JoinOrder<1<<dim> join[dim+1];     // join subsets of codimension
+    int offset[1<<dim];                // first number of binary partition within its codimension
+    int stride[1<<dim][dim];           // lex strides within binary partition
 
     inline int power2 (int i) const {return 1<<i;}
     inline int ones (int b) const;     // count number of bits set in binary rep of b
@@ -548,6 +548,26 @@ namespace Dune {
     for (int i=1; i<dim; i++) dinfo << "," <<  N[L-1][i];
     dinfo << ")" << std::endl;
 
+    // tabulate the subentities of an element with expanded coordinates in {-1,0,1} relative to the element
+    for (int codim=0; codim<=dim; codim++)
+    {
+      const int count = SUnitCubeMapper<dim>::mapper.elements(codim);
+      subshift[codim].resize(count);
+      subpartition[codim].resize(count);
+      for (int i=0; i<count; i++)
+      {
+        // map to old numbering
+        const int j = SGridInternal::CubeNumberingTable<dim>::generic2dune( i, codim );
+
+        // find expanded coordinates of entity in reference cube
+        // has components in {0,1,2}
+        const array<int,dim> zref = SUnitCubeMapper<dim>::mapper.z(j,codim);
+        for (int k=0; k<dim; k++)
+          subshift[codim][i][k] = zref[k] - 1;
+        subpartition[codim][i] = SUnitCubeMapper<dim>::mapper.partition(zref);
+      }
+    }
+
     // initialize boundary segment mappers
     boundarysize = 0;
     for (int d=0; d<dim; d++)
@@ -725,20 +745,25 @@ namespace Dune {
   template<int dim, int dimworld, typename ctype>
   inline array<int,dim> SGrid<dim,dimworld,ctype>::subz (const array<int,dim> & z, int i, int codim) const
   {
-    // map to old numbering
-    const int j = SGridInternal::CubeNumberingTable<dim>::generic2dune( i, codim );
-
-    // find expanded coordinates of entity in reference cube
-    // has components in {0,1,2}
-    array<int,dim> zref = SUnitCubeMapper<dim>::mapper.z(j,codim);
-
     // compute expanded coordinates of entity in global coordinates
+    const array<int,dim> & shift = subshift[codim][i];
     array<int,dim> zentity;
-    for (int k=0; k<dim; k++) zentity[k] = z[k] + zref[k] - 1;
+    for (int k=0; k<dim; k++) zentity[k] = z[k] + shift[k];
 
     return zentity;
   }
 
+  template<int dim, int dimworld, typename ctype>
+  inline int SGrid<dim,dimworld,ctype>::subn (int level, const array<int,dim> & z, int i, int codim) const
+  {
+    // the partition of the subentity is known, so only its compressed coordinate is needed
+    const array<int,dim> & shift = subshift[codim][i];
+    array<int,dim> r;
+    for (int k=0; k<dim; k++) r[k] = (z[k] + shift[k])>>1;
+
+    return mapper[level].n(subpartition[codim][i], r);
+  }
+
 
 
   template<int dim, int dimworld, typename ctype>
@@ -0,0 +1,86 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifndef DUNE_GRID_TEST_CHECKBATCHEDGEOMETRY_CC
+#define DUNE_GRID_TEST_CHECKBATCHEDGEOMETRY_CC
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/common/batchedgeometry.hh>
+
+/** \brief check the batched evaluation of axis-aligned geometries
+ *
+ *  For all entities of the given codimension, the batched global() (array
+ *  of FieldVectors and structure of arrays) and integrationElement() of
+ *  batchedAxisAlignedCubeGeometry() have to equal the pointwise results of
+ *  the entity's geometry.
+ *
+ *  \note This check only makes sense for grids with axis-aligned cube
+ *        geometries (e.g., YaspGrid and SGrid).
+ */
+template< int codim, class GridView >
+void checkBatchedGeometry ( const GridView &gridView )
+{
+  typedef typename GridView::template Codim< codim >::Iterator Iterator;
+  typedef typename GridView::template Codim< codim >::Geometry Geometry;
+
+  typedef typename Geometry::ctype ctype;
+  const int mydim = Geometry::mydimension;
+  const int cdim = Geometry::coorddimension;
+
+  typedef typename Geometry::LocalCoordinate LocalCoordinate;
+  typedef typename Geometry::GlobalCoordinate GlobalCoordinate;
+
+  typedef Dune::BatchedAxisAlignedCubeGeometry< ctype, mydim, cdim > BatchedGeometry;
+
+  // some points inside the reference cube, in both layouts
+  const std::size_t n = 7;
+  std::vector< LocalCoordinate > local( n );
+  std::vector< ctype > localSoA( mydim*n + 1 );
+  for( std::size_t p = 0; p < n; ++p )
+  {
+    for( int j = 0; j < mydim; ++j )
+    {
+      local[ p ][ j ] = ctype( (p*(j+3) + 1) % 11 ) / ctype( 10 );
+      localSoA[ j*n + p ] = local[ p ][ j ];
+    }
+  }
+
+  std::vector< GlobalCoordinate > global( n );
+  std::vector< ctype > globalSoA( cdim*n );
+  std::vector< ctype > integrationElement( n );
+
+  const Iterator end = gridView.template end< codim >();
+  for( Iterator it = gridView.template begin< codim >(); it != end; ++it )
+  {
+    const Geometry geometry = it->geometry();
+    const BatchedGeometry batched = Dune::batchedAxisAlignedCubeGeometry( geometry );
+
+    batched.global( &local[ 0 ], &global[ 0 ], n );
+    batched.global( n, &localSoA[ 0 ], &globalSoA[ 0 ] );
+    batched.integrationElement( &local[ 0 ], &integrationElement[ 0 ], n );
+
+    for( std::size_t p = 0; p < n; ++p )
+    {
+      const GlobalCoordinate x = geometry.global( local[ p ] );
+      const ctype tolerance = 1e-12 * (1 + x.two_norm());
+      for( int k = 0; k < cdim; ++k )
+      {
+        if( std::abs( global[ p ][ k ] - x[ k ] ) > tolerance )
+          DUNE_THROW( Dune::GridError, "Batched global() differs from global() (codim " << codim << ")." );
+        if( std::abs( globalSoA[ k*n + p ] - x[ k ] ) > tolerance )
+          DUNE_THROW( Dune::GridError, "Batched global() (structure of arrays) differs from global() (codim " << codim << ")." );
+      }
+
+      const ctype ie = geometry.integrationElement( local[ p ] );
+      if( std::abs( integrationElement[ p ] - ie ) > 1e-12 * (1 + ie) )
+        DUNE_THROW( Dune::GridError, "Batched integrationElement() differs from integrationElement() (codim " << codim << ")." );
+    }
+  }
+}
+
+#endif // #ifndef DUNE_GRID_TEST_CHECKBATCHEDGEOMETRY_CC
@@ -0,0 +1,128 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief Check the adaptation statistics of a header-only and a library grid
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <bitset>
+#include <iostream>
+#include <string>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/common/adaptationstatistics.hh>
+#include <dune/grid/onedgrid.hh>
+#include <dune/grid/yaspgrid.hh>
+
+// mark all leaf elements for refinement, adapt once and check the counters
+template< class Grid >
+void checkAdaptationStatistics ( Grid &grid, const std::string &name )
+{
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+
+  const Dune::AdaptationStatistics before = grid.adaptationStatistics();
+
+  const GridView gridView = grid.leafGridView();
+  const long oldSize = grid.size( 0 );
+  std::size_t marked = 0;
+  const Iterator end = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    if( grid.mark( 1, *it ) )
+      ++marked;
+  }
+
+  grid.preAdapt();
+  grid.adapt();
+  grid.postAdapt();
+
+  const Dune::AdaptationStatistics &statistics = grid.adaptationStatistics();
+  std::cout << name << ":" << std::endl;
+  statistics.print( std::cout );
+
+  if( marked == 0 )
+    DUNE_THROW( Dune::InvalidStateException, name << ": No elements marked for refinement." );
+  if( statistics.adaptCalls != before.adaptCalls + 1 )
+    DUNE_THROW( Dune::InvalidStateException, name << ": Wrong number of adapt calls: " << statistics.adaptCalls << "." );
+  if( statistics.markedForRefinement != before.markedForRefinement + marked )
+    DUNE_THROW( Dune::InvalidStateException, name << ": Wrong number of elements marked for refinement." );
+  if( statistics.markedForCoarsening != before.markedForCoarsening )
+    DUNE_THROW( Dune::InvalidStateException, name << ": Wrong number of elements marked for coarsening." );
+  if( statistics.refined != before.refined + std::size_t( oldSize ) )
+    DUNE_THROW( Dune::InvalidStateException, name << ": Wrong number of refined elements." );
+  if( statistics.coarsened != before.coarsened )
+    DUNE_THROW( Dune::InvalidStateException, name << ": Wrong number of coarsened elements." );
+  if( statistics.elementDelta - before.elementDelta != grid.size( 0 ) - oldSize )
+    DUNE_THROW( Dune::InvalidStateException, name << ": Wrong change of the number of leaf elements." );
+  if( (statistics.adaptTime < before.adaptTime) || (statistics.globalRefineTime < before.globalRefineTime) )
+    DUNE_THROW( Dune::InvalidStateException, name << ": Adaptation time decreased." );
+}
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  const int dim = 2;
+  typedef Dune::YaspGrid< dim > Grid;
+
+  Dune::FieldVector< double, dim > L( 1.0 );
+  Dune::array< int, dim > s;
+  std::fill( s.begin(), s.end(), 4 );
+  std::bitset< dim > periodic;
+
+#if HAVE_MPI
+  Grid grid( MPI_COMM_WORLD, L, s, periodic, 1 );
+#else
+  Grid grid( L, s, periodic, 1 );
+#endif
+
+  // OneDGrid is compiled into libdunegrid
+  Dune::OneDGrid onedGrid( 8, 0.0, 1.0 );
+
+  if( Dune::AdaptationStatistics::enabled() )
+    DUNE_THROW( Dune::InvalidStateException, "Adaptation statistics enabled by default." );
+
+  // nothing may be recorded while recording is switched off
+  grid.globalRefine( 1 );
+  onedGrid.globalRefine( 1 );
+  if( (grid.adaptationStatistics().refined != 0) || (grid.adaptationStatistics().globalRefineTime != 0.0) )
+    DUNE_THROW( Dune::InvalidStateException, "YaspGrid: Adaptation statistics recorded although switched off." );
+  if( (onedGrid.adaptationStatistics().refined != 0) || (onedGrid.adaptationStatistics().globalRefineTime != 0.0) )
+    DUNE_THROW( Dune::InvalidStateException, "OneDGrid: Adaptation statistics recorded although switched off." );
+
+  Dune::AdaptationStatistics::enable();
+
+  checkAdaptationStatistics( grid, "YaspGrid" );
+  checkAdaptationStatistics( onedGrid, "OneDGrid" );
+
+  // the library grid has to record non-zero counts
+  const Dune::AdaptationStatistics &onedStatistics = onedGrid.adaptationStatistics();
+  if( (onedStatistics.adaptCalls == 0) || (onedStatistics.refined == 0) || (onedStatistics.elementDelta == 0) )
+    DUNE_THROW( Dune::InvalidStateException, "OneDGrid: No adaptation statistics recorded." );
+
+  Dune::AdaptationStatistics reset( onedStatistics );
+  reset.reset();
+  if( (reset.adaptCalls != 0) || (reset.refined != 0) || (reset.elementDelta != 0) )
+    DUNE_THROW( Dune::InvalidStateException, "reset() does not clear the counters." );
+
+  Dune::AdaptationStatistics::enable( false );
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch( ... )
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
@@ -2,8 +2,16 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include <config.h>
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <set>
 #include <sstream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifndef GRIDDIM
 #define GRIDDIM ALBERTA_DIM
@@ -56,6 +64,294 @@ void markOne ( GridType & grid , int num , int ref )
 }
 
 
+// collect the index of each leaf subentity, keyed by its hierarchic index
+template< class Grid, class IndexSet >
+void collectLeafIndices ( const Grid &grid, const IndexSet &indexSet,
+                          std::vector< std::map< int, int > > &indices )
+{
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+
+  const int dim = Grid::dimension;
+  const typename Grid::HierarchicIndexSet &hIndexSet = grid.hierarchicIndexSet();
+
+  indices.assign( dim+1, std::map< int, int >() );
+
+  const GridView gridView = grid.leafView();
+  const Iterator end = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    const Dune::ReferenceElement< double, dim > &refElement
+      = Dune::ReferenceElements< double, dim >::general( it->type() );
+    for( int codim = 0; codim <= dim; ++codim )
+    {
+      for( int i = 0; i < refElement.size( codim ); ++i )
+      {
+        const int hIndex = hIndexSet.subIndex( *it, i, codim );
+        const int index = indexSet.subIndex( *it, i, codim );
+        const std::pair< std::map< int, int >::iterator, bool > result
+          = indices[ codim ].insert( std::make_pair( hIndex, index ) );
+        if( result.first->second != index )
+          DUNE_THROW( Dune::GridError, "Leaf index set assigns different indices to one entity (codim " << codim << ")." );
+      }
+    }
+  }
+
+  // the indices have to be unique and consecutive
+  for( int codim = 0; codim <= dim; ++codim )
+  {
+    std::set< int > used;
+    typedef std::map< int, int >::const_iterator MapIterator;
+    for( MapIterator it = indices[ codim ].begin(); it != indices[ codim ].end(); ++it )
+    {
+      if( (it->second < 0) || (it->second >= indexSet.size( codim )) )
+        DUNE_THROW( Dune::GridError, "Leaf index out of range (codim " << codim << ")." );
+      used.insert( it->second );
+    }
+    if( (int)used.size() != indexSet.size( codim ) )
+      DUNE_THROW( Dune::GridError, "Leaf indices are not consecutive (codim " << codim << ")." );
+    if( used.size() != indices[ codim ].size() )
+      DUNE_THROW( Dune::GridError, "Leaf indices are not unique (codim " << codim << ")." );
+  }
+}
+
+
+// compare the incrementally updated leaf index set with a rebuilt one
+template< class Grid >
+void compareLeafIndexSet ( const Grid &grid )
+{
+  typedef typename Grid::GridFamily::LeafIndexSetImp LeafIndexSetImp;
+  const LeafIndexSetImp &indexSet = static_cast< const LeafIndexSetImp & >( grid.leafIndexSet() );
+
+  LeafIndexSetImp rebuilt( grid.hierarchicIndexSet() );
+  rebuilt.update( grid.template leafbegin< 0 >(), grid.template leafend< 0 >() );
+
+  std::vector< std::map< int, int > > incrementalIndices, rebuiltIndices;
+  collectLeafIndices( grid, indexSet, incrementalIndices );
+  collectLeafIndices( grid, rebuilt, rebuiltIndices );
+
+  for( int codim = 0; codim <= Grid::dimension; ++codim )
+  {
+    if( indexSet.size( codim ) != rebuilt.size( codim ) )
+      DUNE_THROW( Dune::GridError, "Incremental leaf index set has wrong size (codim " << codim << ")." );
+
+    // both index sets have to contain the same entities
+    typedef std::map< int, int >::const_iterator MapIterator;
+    MapIterator it = incrementalIndices[ codim ].begin();
+    MapIterator rit = rebuiltIndices[ codim ].begin();
+    for( ; (it != incrementalIndices[ codim ].end()) && (rit != rebuiltIndices[ codim ].end()); ++it, ++rit )
+    {
+      if( it->first != rit->first )
+        DUNE_THROW( Dune::GridError, "Incremental leaf index set contains wrong entities (codim " << codim << ")." );
+    }
+  }
+}
+
+
+// adaptation data handle checking that the children of a coarsened element
+// keep their leaf index until the adaptation is finished
+template< class Grid >
+class LeafIndexCheckHandle
+  : public Dune::AdaptDataHandle< Grid, LeafIndexCheckHandle< Grid > >
+{
+  typedef typename Grid::template Codim< 0 >::Entity Entity;
+  typedef typename Entity::HierarchicIterator HierarchicIterator;
+
+public:
+  LeafIndexCheckHandle ( const Grid &grid, const std::map< int, int > &indices )
+    : grid_( grid ), indices_( indices ), checked_( 0 ), errors_( 0 )
+  {}
+
+  void preAdapt ( const unsigned int ) {}
+  void postAdapt () {}
+
+  void preCoarsening ( const Entity &father ) const
+  {
+    const int childLevel = father.level() + 1;
+    const HierarchicIterator end = father.hend( childLevel );
+    for( HierarchicIterator it = father.hbegin( childLevel ); it != end; ++it )
+    {
+      const std::map< int, int >::const_iterator pos
+        = indices_.find( grid_.hierarchicIndexSet().index( *it ) );
+      if( pos == indices_.end() )
+        continue;
+      ++checked_;
+      if( grid_.leafIndexSet().index( *it ) != pos->second )
+        ++errors_;
+    }
+  }
+
+  void postRefinement ( const Entity & ) const {}
+
+  int checked () const { return checked_; }
+  int errors () const { return errors_; }
+
+private:
+  const Grid &grid_;
+  const std::map< int, int > &indices_;
+  mutable int checked_;
+  mutable int errors_;
+};
+
+
+// move data stored by leaf index through the compaction map and compare it
+// with the new leaf indices of all entities contained before and after the
+// adaptation
+template< class Grid >
+void checkCompactionMap ( const Grid &grid, const std::vector< std::map< int, int > > &oldIndices )
+{
+  typedef typename Grid::GridFamily::LeafIndexSetImp LeafIndexSetImp;
+  typedef typename LeafIndexSetImp::CompactionMap CompactionMap;
+  const LeafIndexSetImp &indexSet = static_cast< const LeafIndexSetImp & >( grid.leafIndexSet() );
+
+  if( !indexSet.incremental() )
+    return;
+
+  std::vector< std::map< int, int > > newIndices;
+  collectLeafIndices( grid, indexSet, newIndices );
+
+  for( int codim = 0; codim <= Grid::dimension; ++codim )
+  {
+    // store the hierarchic index as data
+    typedef std::map< int, int >::const_iterator MapIterator;
+    std::vector< int > data( oldIndices[ codim ].size(), -1 );
+    for( MapIterator it = oldIndices[ codim ].begin(); it != oldIndices[ codim ].end(); ++it )
+      data[ it->second ] = it->first;
+
+    // migrate the data
+    std::vector< int > newData( data );
+    newData.resize( std::max( data.size(), std::size_t( indexSet.size( codim ) ) ), -1 );
+    const CompactionMap &compactionMap = indexSet.compactionMap( codim );
+    for( typename CompactionMap::const_iterator it = compactionMap.begin(); it != compactionMap.end(); ++it )
+    {
+      if( (it->first < 0) || (it->first >= (int)data.size()) || (it->second < 0) || (it->second >= indexSet.size( codim )) )
+        DUNE_THROW( Dune::GridError, "Compaction map entry out of range (codim " << codim << ")." );
+      newData[ it->second ] = data[ it->first ];
+    }
+    newData.resize( indexSet.size( codim ) );
+
+    for( MapIterator it = newIndices[ codim ].begin(); it != newIndices[ codim ].end(); ++it )
+    {
+      if( oldIndices[ codim ].find( it->first ) == oldIndices[ codim ].end() )
+        continue;
+      if( newData[ it->second ] != it->first )
+        DUNE_THROW( Dune::GridError, "Data moved by the compaction map does not match the new leaf index (codim " << codim << ")." );
+    }
+  }
+}
+
+
+// refine and coarsen some elements repeatedly and check the leaf index set
+// after each adaptation
+template< class Grid >
+void checkLeafIndexSetUpdate ( Grid &grid )
+{
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+
+  std::cout << ">>> Checking incremental update of the leaf index set..." << std::endl;
+
+  // make sure the leaf index set exists, so it is updated incrementally
+  compareLeafIndexSet( grid );
+
+  for( int cycle = 0; cycle < 3; ++cycle )
+  {
+    // refine every third leaf element
+    int count = 0;
+    const Iterator end = grid.leafView().template end< 0 >();
+    for( Iterator it = grid.leafView().template begin< 0 >(); it != end; ++it, ++count )
+    {
+      if( count % 3 == 0 )
+        grid.mark( 1, *it );
+    }
+    grid.preAdapt();
+    grid.adapt();
+    grid.postAdapt();
+    compareLeafIndexSet( grid );
+
+    // coarsen every other leaf element
+    count = 0;
+    const Iterator cend = grid.leafView().template end< 0 >();
+    for( Iterator it = grid.leafView().template begin< 0 >(); it != cend; ++it, ++count )
+    {
+      if( count % 2 == 0 )
+        grid.mark( -1, *it );
+    }
+
+    std::vector< std::map< int, int > > oldIndices;
+    collectLeafIndices( grid, grid.leafIndexSet(), oldIndices );
+
+    // the leaf indices of the children have to stay valid in the callbacks
+    LeafIndexCheckHandle< Grid > handle( grid, oldIndices[ 0 ] );
+    grid.adapt( handle );
+    if( handle.errors() > 0 )
+      DUNE_THROW( Dune::GridError, handle.errors() << " of " << handle.checked() << " leaf indices changed during coarsening." );
+    compareLeafIndexSet( grid );
+    checkCompactionMap( grid, oldIndices );
+  }
+}
+
+
+template< class Grid >
+int countLeafElements ( const Grid &grid )
+{
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+  typedef typename GridView::template Codim< 0 >::EntityPointer EntityPointer;
+
+  const GridView gridView = grid.leafView();
+
+  int count = 0;
+  const Iterator end = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    // copying the entity pointer shares the element info of the iterator
+    const EntityPointer ep( it );
+    if( ep->level() != it->level() )
+      DUNE_THROW( Dune::GridError, "Copied entity pointer has wrong level." );
+    ++count;
+  }
+  return count;
+}
+
+
+// Traversals allocate and release element infos. If OpenMP is available,
+// they are also performed concurrently, with more threads than initially
+// available and within nested parallel regions.
+template< class Grid >
+void checkElementInfoStack ( const Grid &grid )
+{
+  std::cout << ">>> Checking concurrent traversal..." << std::endl;
+
+  const int size = grid.size( 0 );
+  for( int i = 0; i < 2; ++i )
+  {
+    if( countLeafElements( grid ) != size )
+      DUNE_THROW( Dune::GridError, "Wrong number of leaf elements in traversal." );
+  }
+
+#ifdef _OPENMP
+  const int nested = omp_get_nested();
+  omp_set_nested( 1 );
+
+  int errors = 0;
+  const int numThreads = omp_get_max_threads() + 2;
+#pragma omp parallel num_threads( numThreads ) reduction( +: errors )
+  {
+#pragma omp parallel num_threads( 2 ) reduction( +: errors )
+    {
+      if( countLeafElements( grid ) != size )
+        ++errors;
+    }
+  }
+
+  omp_set_nested( nested );
+  if( errors > 0 )
+    DUNE_THROW( Dune::GridError, "Wrong number of leaf elements in " << errors << " concurrent traversals." );
+#endif // #ifdef _OPENMP
+}
+
+
 template< class Grid >
 void checkProjectedUnitCube ()
 {
@@ -158,6 +454,9 @@ try {
       checkIterators( grid.leafView() );
     }
 
+    checkElementInfoStack( grid );
+    checkLeafIndexSetUpdate( grid );
+
     checkGeometryInFather(grid);
     checkIntersectionIterator(grid,true);
     checkTwists( grid.leafView(), NoMapTwist() );
@@ -7,9 +7,14 @@
 
 #define DISABLE_DEPRECATED_METHOD_CHECK 1
 
+#include <cassert>
+#include <cmath>
 #include <iostream>
+#include <map>
+#include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <dune/common/tupleutility.hh>
 #include <dune/common/tuples.hh>
@@ -498,6 +503,688 @@ void checkALUSerial(GridType & grid, int mxl = 2, const bool display = false)
   std::cout << std::endl << std::endl;
 }
 
+// key of an entity for comparing ids across adaptation: codimension, level and rounded center
+typedef std::pair< std::pair< int, int >, std::vector< long > > EntityPositionKey;
+
+// collect the ids of all entities on the levels up to maxLevel
+// - keyed by codimension and hierarchic index (byIndex)
+// - keyed by codimension, level and center (byPosition), which is independent of the numbering
+template <class GridType, class IdSet>
+void collectIds( const GridType& grid, const IdSet& idSet, const int maxLevel,
+                 std::map< std::pair< int, int >, typename IdSet :: IdType >& byIndex,
+                 std::map< EntityPositionKey, typename IdSet :: IdType >& byPosition )
+{
+  enum { dim = GridType :: dimension };
+  typedef typename GridType :: ctype ctype;
+  typedef typename GridType :: template Codim< 0 > :: LevelIterator LevelIterator;
+  typedef typename IdSet :: IdType IdType;
+  typedef typename std::map< std::pair< int, int >, IdType > :: iterator IndexIterator;
+
+  byIndex.clear();
+  byPosition.clear();
+  for( int level = 0; level <= maxLevel; ++level )
+  {
+    const LevelIterator end = grid.template lend< 0 >( level );
+    for( LevelIterator it = grid.template lbegin< 0 >( level ); it != end; ++it )
+    {
+      const ReferenceElement< ctype, dim > &refElem = ReferenceElements< ctype, dim >::general( it->type() );
+      for( int codim = 0; codim <= dim; ++codim )
+      {
+        for( int i = 0; i < refElem.size( codim ); ++i )
+        {
+          const IdType id = idSet.subId( *it, i, codim );
+
+          const std::pair< int, int > index( codim, grid.hierarchicIndexSet().subIndex( *it, i, codim ) );
+          const std::pair< IndexIterator, bool > entry = byIndex.insert( std::make_pair( index, id ) );
+          if( entry.first->second != id )
+            DUNE_THROW( InvalidStateException, "Entity has different ids when seen from different elements!" );
+
+          const FieldVector< ctype, GridType :: dimensionworld > center = it->geometry().global( refElem.position( i, codim ) );
+          EntityPositionKey key( std::make_pair( codim, level ), std::vector< long >( GridType :: dimensionworld ) );
+          for( int k = 0; k < GridType :: dimensionworld; ++k )
+            key.second[ k ] = long( std::floor( center[ k ] * 1e8 + 0.5 ) );
+          byPosition[ key ] = id;
+        }
+      }
+    }
+  }
+}
+
+// compare the global ids with those of a newly built id set (only for ALU3dGridGlobalIdSet)
+template <class GridType, class GlobalIdSetImp>
+struct CheckGlobalIdRebuild
+{
+  template <class IdMap>
+  static void apply ( const GridType& grid, const IdMap& ids ) {}
+};
+
+#if ALU3DGRID_PARALLEL
+template <class GridType, ALU3dGridElementType elType>
+struct CheckGlobalIdRebuild< GridType, ALU3dGridGlobalIdSet< elType, MPI_Comm > >
+{
+  template <class IdMap>
+  static void apply ( const GridType& grid, const IdMap& ids )
+  {
+    typedef ALU3dGridGlobalIdSet< elType, MPI_Comm > IdSet;
+    const IdSet rebuilt( grid );
+    IdMap rebuiltIds;
+    std::map< EntityPositionKey, typename IdSet :: IdType > byPosition;
+    collectIds( grid, rebuilt, grid.maxLevel(), rebuiltIds, byPosition );
+    if( rebuiltIds != ids )
+      DUNE_THROW( InvalidStateException, "Global ids differ from a rebuilt id set!" );
+  }
+};
+#endif // #if ALU3DGRID_PARALLEL
+
+// the global ids are updated during adaptation; they have to be unique,
+// must not change for entities surviving the adaptation and have to
+// match the ids of a rebuilt id set
+template <class GridType>
+void checkGlobalIdsAfterAdaptation( GridType& grid )
+{
+  typedef typename GridType :: GlobalIdSet :: IdType IdType;
+  typedef std::map< std::pair< int, int >, IdType > IndexMap;
+  typedef std::map< EntityPositionKey, IdType > PositionMap;
+  typedef typename ALU3dGridCommunications< GridType :: elementType, typename GridType :: MPICommunicatorType > :: GlobalIdSet GlobalIdSetImp;
+  typedef typename GridType :: template Codim< 0 > :: LeafIterator LeafIterator;
+
+  // refine everything in the first step, coarsen everything in the second one
+  for( int step = 0; step < 2; ++step )
+  {
+    IndexMap oldByIndex;
+    PositionMap oldByPosition;
+    collectIds( grid, grid.globalIdSet(), grid.maxLevel(), oldByIndex, oldByPosition );
+
+    const LeafIterator end = grid.template leafend< 0 >();
+    for( LeafIterator it = grid.template leafbegin< 0 >(); it != end; ++it )
+      grid.mark( (step == 0 ? 1 : -1), *it );
+    grid.preAdapt();
+    grid.adapt();
+    grid.postAdapt();
+
+    IndexMap byIndex;
+    PositionMap byPosition;
+    collectIds( grid, grid.globalIdSet(), grid.maxLevel(), byIndex, byPosition );
+
+    std::set< IdType > uniqueIds;
+    for( typename IndexMap :: const_iterator it = byIndex.begin(); it != byIndex.end(); ++it )
+      uniqueIds.insert( it->second );
+    if( uniqueIds.size() != byIndex.size() )
+      DUNE_THROW( InvalidStateException, "Global ids are not unique after adaptation!" );
+
+    // refinement only creates and coarsening only removes entities, so
+    // entities found before and after adaptation are the same ones
+    for( typename PositionMap :: const_iterator it = byPosition.begin(); it != byPosition.end(); ++it )
+    {
+      const typename PositionMap :: const_iterator old = oldByPosition.find( it->first );
+      if( (old != oldByPosition.end()) && (old->second != it->second) )
+        DUNE_THROW( InvalidStateException, "Global id changed during adaptation!" );
+      if( (old == oldByPosition.end()) && (it->first.first.second == 0) )
+        DUNE_THROW( InvalidStateException, "Macro entity not found after adaptation!" );
+    }
+
+    CheckGlobalIdRebuild< GridType, GlobalIdSetImp > :: apply( grid, byIndex );
+  }
+}
+
+// collect normals and local geometries of all leaf intersections
+template <class GridView>
+void collectFaceGeometries( const GridView& gridView, std::vector< double >& data )
+{
+  typedef typename GridView :: template Codim< 0 > :: Iterator Iterator ;
+  typedef typename GridView :: IntersectionIterator IntersectionIterator ;
+  typedef typename IntersectionIterator :: Intersection Intersection;
+  typedef typename Intersection :: LocalGeometry LocalGeometry;
+
+  data.clear();
+  const Iterator endit = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != endit ; ++it )
+  {
+    const IntersectionIterator endnit = gridView.iend( *it );
+    for( IntersectionIterator nit = gridView.ibegin( *it ); nit != endnit; ++nit )
+    {
+      const Intersection& intersection = * nit ;
+      const typename Intersection :: LocalCoordinate x( 0.25 );
+
+      const typename Intersection :: GlobalCoordinate normal = intersection.integrationOuterNormal( x );
+      const typename Intersection :: GlobalCoordinate unitNormal = intersection.unitOuterNormal( x );
+      data.insert( data.end(), normal.begin(), normal.end() );
+      data.insert( data.end(), unitNormal.begin(), unitNormal.end() );
+
+      const LocalGeometry& geoInInside = intersection.geometryInInside();
+      for( int i = 0; i < geoInInside.corners(); ++i )
+        data.insert( data.end(), geoInInside.corner( i ).begin(), geoInInside.corner( i ).end() );
+      if( intersection.neighbor() )
+      {
+        const LocalGeometry& geoInOutside = intersection.geometryInOutside();
+        for( int i = 0; i < geoInOutside.corners(); ++i )
+          data.insert( data.end(), geoInOutside.corner( i ).begin(), geoInOutside.corner( i ).end() );
+      }
+    }
+  }
+}
+
+// intersections with cached face geometries have to equal the uncached ones
+template <class GridType>
+void checkFaceGeometryCache( GridType& grid )
+{
+  std::vector< double > reference, cached;
+  collectFaceGeometries( grid.leafView(), reference );
+
+  grid.faceGeometryCaching( true );
+  // first sweep fills the cache, second one uses it
+  for( int sweep = 0; sweep < 2; ++sweep )
+  {
+    collectFaceGeometries( grid.leafView(), cached );
+    if( cached != reference )
+      DUNE_THROW( InvalidStateException, "Cached face geometries differ in sweep " << sweep << "!" );
+  }
+
+  // adaptation has to invalidate the cache
+  grid.globalRefine( 1 );
+  grid.faceGeometryCaching( false );
+  collectFaceGeometries( grid.leafView(), reference );
+  grid.faceGeometryCaching( true );
+  for( int sweep = 0; sweep < 2; ++sweep )
+  {
+    collectFaceGeometries( grid.leafView(), cached );
+    if( cached != reference )
+      DUNE_THROW( InvalidStateException, "Cached face geometries differ after refinement!" );
+  }
+  grid.faceGeometryCaching( false );
+}
+
+#if USE_PARALLEL_TEST
+// adds the received data items of an entity to its own ones
+template <class IndexSet, int codim, class Impl>
+class SumDataHandleBase
+  : public CommDataHandleIF< Impl, double >
+{
+public:
+  static const std::size_t numItems = 3;
+
+  SumDataHandleBase( const IndexSet& indexSet, std::vector< double >& data )
+    : indexSet_( indexSet ), data_( data )
+  {}
+
+  bool contains ( int dim, int cd ) const { return (cd == codim); }
+  bool fixedsize ( int dim, int cd ) const { return true; }
+
+  template <class Entity>
+  std::size_t size ( const Entity& entity ) const { return numItems; }
+
+  template <class Buffer, class Entity>
+  void gather ( Buffer& buffer, const Entity& entity ) const
+  {
+    const std::size_t index = indexSet_.index( entity );
+    for( std::size_t k = 0; k < numItems; ++k )
+      buffer.write( data_[ numItems*index + k ] );
+  }
+
+  template <class Buffer, class Entity>
+  void scatter ( Buffer& buffer, const Entity& entity, std::size_t n )
+  {
+    assert( n == numItems );
+    const std::size_t index = indexSet_.index( entity );
+    for( std::size_t k = 0; k < n; ++k )
+    {
+      double x;
+      buffer.read( x );
+      data_[ numItems*index + k ] += x;
+    }
+  }
+
+protected:
+  const IndexSet& indexSet_;
+  std::vector< double >& data_;
+};
+
+// communicates the data item by item
+template <class IndexSet, int codim>
+class SumDataHandle
+  : public SumDataHandleBase< IndexSet, codim, SumDataHandle< IndexSet, codim > >
+{
+  typedef SumDataHandleBase< IndexSet, codim, SumDataHandle< IndexSet, codim > > Base;
+
+public:
+  SumDataHandle( const IndexSet& indexSet, std::vector< double >& data )
+    : Base( indexSet, data )
+  {}
+};
+
+// communicates the data of each entity as one block
+template <class IndexSet, int codim>
+class BatchSumDataHandle
+  : public SumDataHandleBase< IndexSet, codim, BatchSumDataHandle< IndexSet, codim > >,
+    public HasBatchGatherScatter
+{
+  typedef SumDataHandleBase< IndexSet, codim, BatchSumDataHandle< IndexSet, codim > > Base;
+
+  using Base::numItems;
+  using Base::indexSet_;
+  using Base::data_;
+
+public:
+  BatchSumDataHandle( const IndexSet& indexSet, std::vector< double >& data )
+    : Base( indexSet, data ), batchCalls_( 0 )
+  {}
+
+  template <class Entity>
+  void gatherBatch ( const Entity& entity, double* data ) const
+  {
+    const std::size_t index = indexSet_.index( entity );
+    for( std::size_t k = 0; k < numItems; ++k )
+      data[ k ] = data_[ numItems*index + k ];
+    ++batchCalls_;
+  }
+
+  template <class Entity>
+  void scatterBatch ( const Entity& entity, const double* data, std::size_t n )
+  {
+    assert( n == numItems );
+    const std::size_t index = indexSet_.index( entity );
+    for( std::size_t k = 0; k < n; ++k )
+      data_[ numItems*index + k ] += data[ k ];
+    ++batchCalls_;
+  }
+
+  //! number of calls to gatherBatch and scatterBatch
+  int batchCalls () const { return batchCalls_; }
+
+private:
+  mutable int batchCalls_;
+};
+
+// batch communication has to yield the same result as the item-by-item one
+template <class GridType>
+void checkBatchCommunication( GridType& grid )
+{
+  typedef typename GridType :: LeafGridView GridView;
+  typedef typename GridView :: IndexSet IndexSet;
+
+  const int dim = GridType :: dimension;
+  const GridView gridView = grid.leafGridView();
+  const IndexSet& indexSet = gridView.indexSet();
+
+  typedef SumDataHandle< IndexSet, dim > DataHandle;
+  typedef BatchSumDataHandle< IndexSet, dim > BatchDataHandle;
+
+  // the sums are exact, so the results can be compared exactly
+  const std::size_t numItems = DataHandle :: numItems;
+  std::vector< double > data( numItems * indexSet.size( dim ) );
+  for( std::size_t i = 0; i < data.size(); ++i )
+    data[ i ] = (grid.comm().rank() + 1) * (i % numItems + 1);
+  std::vector< double > batchData( data );
+
+  DataHandle dataHandle( indexSet, data );
+  gridView.communicate( dataHandle, InteriorBorder_InteriorBorder_Interface, ForwardCommunication );
+
+  BatchDataHandle batchDataHandle( indexSet, batchData );
+  gridView.communicate( batchDataHandle, InteriorBorder_InteriorBorder_Interface, ForwardCommunication );
+
+  if( grid.comm().sum( batchDataHandle.batchCalls() ) == 0 )
+    DUNE_THROW( InvalidStateException, "Batch gather / scatter not used in communication!" );
+  if( batchData != data )
+    DUNE_THROW( InvalidStateException, "Batch communication differs from item-by-item communication!" );
+}
+// data of an entity used to check the migration during load balancing
+template <class Entity>
+std::vector< double > loadBalanceData( const Entity& entity )
+{
+  typedef typename Entity :: Geometry Geometry;
+  const typename Geometry :: GlobalCoordinate center = entity.geometry().center();
+
+  // the number of items depends on the entity to test variable sizes
+  std::vector< double > data( 1 + entity.level() );
+  for( std::size_t k = 0; k < data.size(); ++k )
+  {
+    data[ k ] = entity.level();
+    for( int i = 0; i < Geometry :: coorddimension; ++i )
+      data[ k ] += (k+1) * center[ i ];
+  }
+  return data;
+}
+
+// migrates the data of elements and vertices, counting the data written and read
+template <class GridType>
+class LoadBalanceDataHandle
+  : public CommDataHandleIF< LoadBalanceDataHandle< GridType >, double >
+{
+  typedef typename GridType :: GlobalIdSet GlobalIdSet;
+
+public:
+  typedef typename GlobalIdSet :: IdType IdType;
+  typedef std::map< IdType, std::vector< double > > DataMap;
+
+  LoadBalanceDataHandle( const GridType& grid, DataMap& data )
+    : idSet_( grid.globalIdSet() ), data_( data ),
+      sentBytes_( 0 ), receivedBytes_( 0 )
+  {}
+
+  bool contains ( int dim, int codim ) const { return (codim == 0) || (codim == dim); }
+  bool fixedsize ( int dim, int codim ) const { return false; }
+
+  template <class Entity>
+  std::size_t size ( const Entity& entity ) const
+  {
+    const typename DataMap :: const_iterator it = data_.find( idSet_.id( entity ) );
+    assert( it != data_.end() );
+    return it->second.size();
+  }
+
+  template <class Buffer, class Entity>
+  void gather ( Buffer& buffer, const Entity& entity ) const
+  {
+    const typename DataMap :: const_iterator it = data_.find( idSet_.id( entity ) );
+    assert( it != data_.end() );
+    for( std::size_t k = 0; k < it->second.size(); ++k )
+      buffer.write( it->second[ k ] );
+    sentBytes_ += sizeof( std::size_t ) + it->second.size() * sizeof( double );
+  }
+
+  template <class Buffer, class Entity>
+  void scatter ( Buffer& buffer, const Entity& entity, std::size_t n )
+  {
+    std::vector< double >& data = data_[ idSet_.id( entity ) ];
+    data.resize( n );
+    for( std::size_t k = 0; k < n; ++k )
+      buffer.read( data[ k ] );
+    receivedBytes_ += sizeof( std::size_t ) + n * sizeof( double );
+  }
+
+  //! size of the data written (including the size of each entity's data)
+  std::size_t sentBytes () const { return sentBytes_; }
+  //! size of the data read (including the size of each entity's data)
+  std::size_t receivedBytes () const { return receivedBytes_; }
+
+private:
+  const GlobalIdSet& idSet_;
+  DataMap& data_;
+  mutable std::size_t sentBytes_;
+  std::size_t receivedBytes_;
+};
+
+// store the data of an entity or compare it with the stored one
+template <class Entity, class IdSet, class DataMap>
+void loadBalanceEntityData( const Entity& entity, const IdSet& idSet, DataMap& data, const bool check )
+{
+  const std::vector< double > reference = loadBalanceData( entity );
+  if( !check )
+  {
+    data[ idSet.id( entity ) ] = reference;
+    return;
+  }
+
+  const typename DataMap :: const_iterator it = data.find( idSet.id( entity ) );
+  if( it == data.end() )
+    DUNE_THROW( InvalidStateException, "Data of entity (codim " << Entity :: codimension << ") lost during load balancing!" );
+  if( it->second.size() != reference.size() )
+    DUNE_THROW( InvalidStateException, "Wrong data size after load balancing!" );
+  for( std::size_t k = 0; k < reference.size(); ++k )
+  {
+    if( std::abs( it->second[ k ] - reference[ k ] ) > 1e-10 )
+      DUNE_THROW( InvalidStateException, "Wrong data after load balancing!" );
+  }
+}
+
+// fill (or check) the data of all interior elements and their vertices
+template <class GridType, class DataMap>
+void loadBalanceData( const GridType& grid, DataMap& data, const bool check )
+{
+  typedef typename GridType :: LevelGridView MacroView;
+  typedef typename MacroView :: template Codim< 0 > :: template Partition< Interior_Partition > :: Iterator MacroIterator;
+  typedef typename GridType :: HierarchicIterator HierarchicIterator;
+  typedef typename GridType :: template Codim< 0 > :: EntityPointer ElementPointer;
+  typedef typename GridType :: template Codim< GridType :: dimension > :: EntityPointer VertexPointer;
+
+  const int dim = GridType :: dimension;
+  const int maxLevel = grid.maxLevel();
+  const typename GridType :: GlobalIdSet& idSet = grid.globalIdSet();
+
+  const MacroView macroView = grid.levelGridView( 0 );
+  const MacroIterator mend = macroView.template end< 0, Interior_Partition >();
+  for( MacroIterator mit = macroView.template begin< 0, Interior_Partition >(); mit != mend; ++mit )
+  {
+    // the macro element and all its descendants
+    std::vector< ElementPointer > elements( 1, ElementPointer( mit ) );
+    const HierarchicIterator hend = mit->hend( maxLevel );
+    for( HierarchicIterator hit = mit->hbegin( maxLevel ); hit != hend; ++hit )
+      elements.push_back( ElementPointer( hit ) );
+
+    for( std::size_t i = 0; i < elements.size(); ++i )
+    {
+      loadBalanceEntityData( *elements[ i ], idSet, data, check );
+      const int numVertices = elements[ i ]->template count< dim >();
+      for( int j = 0; j < numVertices; ++j )
+      {
+        const VertexPointer vertex = elements[ i ]->template subEntity< dim >( j );
+        loadBalanceEntityData( *vertex, idSet, data, check );
+      }
+    }
+  }
+}
+
+// load balancing with a data handle has to migrate all data and has to
+// record the migrated data volume
+template <class GridType>
+void checkLoadBalance( GridType& grid )
+{
+  typedef LoadBalanceDataHandle< GridType > DataHandle;
+  typename DataHandle :: DataMap data;
+  loadBalanceData( grid, data, false );
+
+  const AdaptationStatistics before = grid.adaptationStatistics();
+  const bool wasEnabled = AdaptationStatistics :: enabled();
+  AdaptationStatistics :: enable();
+
+  DataHandle dataHandle( grid, data );
+  CommDataHandleIF< DataHandle, double >& dataHandleIF = dataHandle;
+  grid.loadBalance( dataHandleIF );
+
+  AdaptationStatistics :: enable( wasEnabled );
+
+  loadBalanceData( grid, data, true );
+
+  // everything sent has to be received
+  if( grid.comm().sum( dataHandle.sentBytes() ) != grid.comm().sum( dataHandle.receivedBytes() ) )
+    DUNE_THROW( InvalidStateException, "Amount of data sent and received during load balancing differs!" );
+
+  const AdaptationStatistics& after = grid.adaptationStatistics();
+  if( after.loadBalanceCalls != before.loadBalanceCalls + 1 )
+    DUNE_THROW( InvalidStateException, "Load balancing call not recorded!" );
+  if( after.sentBytes - before.sentBytes != dataHandle.sentBytes() )
+    DUNE_THROW( InvalidStateException, "Wrong number of bytes sent recorded!" );
+  if( after.receivedBytes - before.receivedBytes != dataHandle.receivedBytes() )
+    DUNE_THROW( InvalidStateException, "Wrong number of bytes received recorded!" );
+  if( grid.comm().sum( after.sentElements - before.sentElements )
+      != grid.comm().sum( after.receivedElements - before.receivedElements ) )
+    DUNE_THROW( InvalidStateException, "Number of elements sent and received differs!" );
+}
+#endif // #if USE_PARALLEL_TEST
+
+// objects handed out by the memory providers in checkMemoryProvider
+struct MemoryProviderObject
+{
+  int value;
+};
+
+// thread information for ALUThreadLocalMemoryProvider without threads
+struct SingleThreadInfo
+{
+  static int threadNumber () { return 0; }
+  static int maxThreads () { return 1; }
+};
+
+void checkMemoryProviderStatistics( const ALUMemoryProviderStatistics& statistics,
+                                    unsigned long allocations, unsigned long reuses,
+                                    unsigned long deletions, long objects, long peakObjects )
+{
+  if( (statistics.allocations != allocations) || (statistics.reuses != reuses)
+      || (statistics.deletions != deletions) || (statistics.objects != objects)
+      || (statistics.peakObjects != peakObjects) )
+  {
+    statistics.print( std::cerr );
+    DUNE_THROW( InvalidStateException, "Wrong memory provider statistics!" );
+  }
+}
+
+// check capacity limiting and statistics of the memory providers
+void checkMemoryProvider()
+{
+  typedef ALUMemoryProvider< MemoryProviderObject > Provider;
+
+  Provider provider;
+  provider.setCapacity( Provider :: maxObjects + 1 );
+  if( provider.capacity() != Provider :: maxObjects )
+    DUNE_THROW( InvalidStateException, "Memory provider capacity not limited to maxObjects!" );
+  provider.setCapacity( -1 );
+  if( provider.capacity() != 0 )
+    DUNE_THROW( InvalidStateException, "Negative memory provider capacity!" );
+
+  // keep at most 2 freed objects
+  provider.setCapacity( 2 );
+  std::vector< MemoryProviderObject* > objects;
+  for( int i = 0; i < 4; ++i )
+    objects.push_back( provider.getEmptyObject() );
+  checkMemoryProviderStatistics( provider.statistics(), 4, 0, 0, 4, 4 );
+  for( int i = 0; i < 4; ++i )
+    provider.freeObject( objects[ i ] );
+  checkMemoryProviderStatistics( provider.statistics(), 4, 0, 2, 0, 4 );
+
+  // 2 objects are reused, the third one is allocated
+  objects.clear();
+  for( int i = 0; i < 3; ++i )
+    objects.push_back( provider.getEmptyObject() );
+  checkMemoryProviderStatistics( provider.statistics(), 5, 2, 2, 3, 4 );
+  for( int i = 0; i < 3; ++i )
+    provider.freeObject( objects[ i ] );
+  checkMemoryProviderStatistics( provider.statistics(), 5, 2, 3, 0, 4 );
+
+  // reducing the capacity releases the kept objects
+  provider.setCapacity( 0 );
+  MemoryProviderObject* object = provider.getEmptyObject();
+  checkMemoryProviderStatistics( provider.statistics(), 6, 2, 3, 1, 4 );
+
+  // objects may be freed by another provider
+  Provider other;
+  other.freeObject( object );
+  checkMemoryProviderStatistics( other.statistics(), 0, 0, 0, -1, 0 );
+  ALUMemoryProviderStatistics sum = provider.statistics();
+  sum += other.statistics();
+  checkMemoryProviderStatistics( sum, 6, 2, 3, 0, 4 );
+
+  // the capacity is passed on to the provider of each thread
+  typedef ALUThreadLocalMemoryProvider< MemoryProviderObject, SingleThreadInfo > ThreadLocalProvider;
+  ThreadLocalProvider threadLocal( 1 );
+  if( threadLocal().capacity() != 1 )
+    DUNE_THROW( InvalidStateException, "Thread local memory provider ignores capacity!" );
+  objects.clear();
+  for( int i = 0; i < 2; ++i )
+    objects.push_back( threadLocal().getEmptyObject() );
+  for( int i = 0; i < 2; ++i )
+    threadLocal().freeObject( objects[ i ] );
+  checkMemoryProviderStatistics( threadLocal.statistics(), 2, 0, 1, 0, 2 );
+  threadLocal.setCapacity( 0 );
+  if( threadLocal().capacity() != 0 )
+    DUNE_THROW( InvalidStateException, "Thread local memory provider capacity not updated!" );
+}
+
+// the corners of the parallelepiped spanned by e[ 0 ], e[ 1 ], e[ 2 ], scaled by h
+// (the position is scaled as well, so that rounding errors scale with h)
+void parallelepipedCorners( const double h, TrilinearMapping::coord_t (&p)[ 8 ] )
+{
+  typedef TrilinearMapping::coord_t Coordinate;
+  Coordinate e[ 3 ];
+  e[ 0 ][ 0 ] = 1.0;  e[ 0 ][ 1 ] = 0.2;  e[ 0 ][ 2 ] = 0.1;
+  e[ 1 ][ 0 ] = 0.3;  e[ 1 ][ 1 ] = 1.5;  e[ 1 ][ 2 ] = -0.2;
+  e[ 2 ][ 0 ] = -0.1; e[ 2 ][ 1 ] = 0.4;  e[ 2 ][ 2 ] = 0.8;
+  for( int i = 0; i < 8; ++i )
+  {
+    p[ i ] = h;
+    for( int k = 0; k < 3; ++k )
+    {
+      if( i & (1 << k) )
+        p[ i ].axpy( h, e[ k ] );
+    }
+  }
+}
+
+// Newton iteration for the local coordinate of a global one
+TrilinearMapping::coord_t newtonLocal( TrilinearMapping& mapping, const TrilinearMapping::coord_t& global )
+{
+  TrilinearMapping::coord_t local( 0.5 );
+  for( int i = 0; i < 100; ++i )
+  {
+    TrilinearMapping::coord_t residual;
+    mapping.map2world( local, residual );
+    residual -= global;
+    TrilinearMapping::coord_t update;
+    mapping.jacobianInverseTransposed( local ).mtv( residual, update );
+    local -= update;
+    if( update.two_norm() < 1e-14 )
+      break;
+  }
+  return local;
+}
+
+// local( global( x ) ) has to reproduce x and agree with the Newton result
+void checkTrilinearMappingInverse( TrilinearMapping& mapping, const std::string& name )
+{
+  const double tolerance = 1e-10;
+  for( int i = 0; i < 27; ++i )
+  {
+    TrilinearMapping::coord_t x;
+    x[ 0 ] = 0.1 + 0.4 * (i % 3);
+    x[ 1 ] = 0.1 + 0.4 * ((i / 3) % 3);
+    x[ 2 ] = 0.1 + 0.4 * (i / 9);
+
+    TrilinearMapping::coord_t global, local;
+    mapping.map2world( x, global );
+    mapping.world2map( global, local );
+    if( (local - x).two_norm() > tolerance )
+      DUNE_THROW( InvalidStateException, "TrilinearMapping (" << name << "): local( global( x ) ) != x!" );
+    if( (local - newtonLocal( mapping, global )).two_norm() > tolerance )
+      DUNE_THROW( InvalidStateException, "TrilinearMapping (" << name << "): local() differs from Newton iteration!" );
+  }
+}
+
+// affine hexahedra (parallelepipeds) of any size are detected, distorted
+// or degenerate ones are not
+void checkTrilinearMapping()
+{
+  typedef TrilinearMapping::coord_t Coordinate;
+  Coordinate p[ 8 ];
+
+  const double sizes[ 3 ] = { 1.0, 1e-6, 1e6 };
+  for( int s = 0; s < 3; ++s )
+  {
+    parallelepipedCorners( sizes[ s ], p );
+    TrilinearMapping mapping( p[ 0 ], p[ 1 ], p[ 2 ], p[ 3 ], p[ 4 ], p[ 5 ], p[ 6 ], p[ 7 ] );
+    if( !mapping.affine() )
+      DUNE_THROW( InvalidStateException, "Parallelepiped not detected as affine (size " << sizes[ s ] << ")!" );
+    checkTrilinearMappingInverse( mapping, "parallelepiped" );
+
+    // the copy has to keep the precomputed derivatives
+    TrilinearMapping copy( mapping );
+    checkTrilinearMappingInverse( copy, "copied parallelepiped" );
+
+    // slightly move one corner
+    Coordinate q[ 8 ];
+    parallelepipedCorners( sizes[ s ], q );
+    q[ 7 ][ 2 ] += 1e-4 * sizes[ s ];
+    TrilinearMapping distorted( q[ 0 ], q[ 1 ], q[ 2 ], q[ 3 ], q[ 4 ], q[ 5 ], q[ 6 ], q[ 7 ] );
+    if( distorted.affine() )
+      DUNE_THROW( InvalidStateException, "Distorted hexahedron detected as affine (size " << sizes[ s ] << ")!" );
+    checkTrilinearMappingInverse( distorted, "distorted hexahedron" );
+  }
+
+  // a mapping of zero size must not be treated as affine
+  const Coordinate x( 1.0 );
+  TrilinearMapping degenerate( x, x, x, x, x, x, x, x );
+  if( degenerate.affine() )
+    DUNE_THROW( InvalidStateException, "Degenerate hexahedron detected as affine!" );
+}
+
 template <class GridType>
 void checkALUParallel(GridType & grid, int gref, int mxl = 3)
 {
@@ -509,12 +1196,27 @@ void checkALUParallel(GridType & grid, int gref, int mxl = 3)
 
   // -1 stands for leaf check
   checkCommunication(grid, -1, std::cout);
+  checkBatchCommunication( grid );
 
   if( Capabilities :: isLevelwiseConforming< GridType > :: v )
   {
     for(int l=0; l<= mxl; ++l)
       checkCommunication(grid, l , Dune::dvverb);
   }
+
+  // refine on the first process only, so that load balancing migrates elements
+  if( grid.comm().rank() == 0 )
+  {
+    typedef typename GridType :: template Codim<0> ::
+    template Partition<Interior_Partition> :: LeafIterator LeafIterator;
+
+    const LeafIterator endit = grid.template leafend<0,Interior_Partition> ();
+    for( LeafIterator it = grid.template leafbegin<0,Interior_Partition> (); it != endit; ++it )
+      grid.mark( 1, *it );
+  }
+  grid.adapt();
+  grid.postAdapt();
+  checkLoadBalance( grid );
 #endif
 }
 
@@ -527,6 +1229,12 @@ int main (int argc , char **argv) {
   int mysize = mpihelper.size();
 
   try {
+    std::cout << "Check memory provider" << std::endl;
+    checkMemoryProvider();
+
+    std::cout << "Check trilinear mapping" << std::endl;
+    checkTrilinearMapping();
+
     /* use grid-file appropriate for dimensions */
 
     std::string key;
@@ -720,6 +1428,18 @@ int main (int argc , char **argv) {
                          (mysize == 1) ? display : false);
         }
 
+        if( mysize == 1 )
+        {
+          std::cout << "Check global ids after adaptation" << std::endl;
+          checkGlobalIdsAfterAdaptation( grid );
+        }
+
+        if( mysize == 1 )
+        {
+          std::cout << "Check face geometry cache" << std::endl;
+          checkFaceGeometryCache( grid );
+        }
+
         // perform parallel check only when more then one proc
         if(mysize > 1)
         {
@@ -752,6 +1472,18 @@ int main (int argc , char **argv) {
                          (mysize == 1) ? display : false);
         }
 
+        if( mysize == 1 )
+        {
+          std::cout << "Check global ids after adaptation" << std::endl;
+          checkGlobalIdsAfterAdaptation( grid );
+        }
+
+        if( mysize == 1 )
+        {
+          std::cout << "Check face geometry cache" << std::endl;
+          checkFaceGeometryCache( grid );
+        }
+
         // perform parallel check only when more then one proc
         if(mysize > 1)
         {
@@ -784,6 +1516,18 @@ int main (int argc , char **argv) {
                          (mysize == 1) ? display : false);
         }
 
+        if( mysize == 1 )
+        {
+          std::cout << "Check global ids after adaptation" << std::endl;
+          checkGlobalIdsAfterAdaptation( grid );
+        }
+
+        if( mysize == 1 )
+        {
+          std::cout << "Check face geometry cache" << std::endl;
+          checkFaceGeometryCache( grid );
+        }
+
         // perform parallel check only when more then one proc
         if(mysize > 1)
         {
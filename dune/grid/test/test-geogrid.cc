@@ -10,6 +10,11 @@
   #define GCCPOOL
 #endif
 
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
 #include <dune/common/timer.hh>
 
 #include <dune/common/poolallocator.hh>
@@ -71,6 +76,98 @@ typedef Dune::GeometryGrid< Grid, CoordFunction, __gnu_cxx::__pool_alloc<char> >
 #endif
 typedef Dune::GeometryGrid< Grid, CoordFunction, Dune::DebugAllocator<char> > GeometryGridWithDebugAllocator;
 
+// collect the corners and volumes of all element geometries of a grid view
+template< class GridView >
+void collectGeometries ( const GridView &gridView, std::vector< double > &data )
+{
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+  typedef typename GridView::template Codim< 0 >::Geometry Geometry;
+
+  data.clear();
+  const Iterator end = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    const Geometry geometry = it->geometry();
+    for( int i = 0; i < geometry.corners(); ++i )
+    {
+      const typename Geometry::GlobalCoordinate corner = geometry.corner( i );
+      data.insert( data.end(), corner.begin(), corner.end() );
+    }
+    data.push_back( geometry.volume() );
+  }
+}
+
+// geometries taken from the cache have to equal the computed ones,
+// also after the grid has been refined
+template< class GeometryGridType >
+void checkGeometryCache ( GeometryGridType &geogrid )
+{
+  std::vector< double > reference, cached;
+  collectGeometries( geogrid.leafGridView(), reference );
+
+  geogrid.cacheGeometries( true );
+  // the first sweep fills the cache, the second one uses it
+  for( int sweep = 0; sweep < 2; ++sweep )
+  {
+    collectGeometries( geogrid.leafGridView(), cached );
+    if( cached != reference )
+      DUNE_THROW( Dune::GridError, "Cached geometries differ in sweep " << sweep << "." );
+  }
+
+  // globalRefine calls update(), which has to clear the cache filled above
+  geogrid.globalRefine( 1 );
+  collectGeometries( geogrid.leafGridView(), cached );
+  collectGeometries( geogrid.leafGridView(), cached );
+  geogrid.cacheGeometries( false );
+  collectGeometries( geogrid.leafGridView(), reference );
+  if( cached != reference )
+    DUNE_THROW( Dune::GridError, "Cached geometries not invalidated by update()." );
+}
+
+#if CACHECOORDFUNCTION
+// compare the corners and volumes of all elements of two grid views
+template< class GridViewA, class GridViewB >
+void compareGeometries ( const GridViewA &gridViewA, const GridViewB &gridViewB, const std::string &what )
+{
+  std::vector< double > a, b;
+  collectGeometries( gridViewA, a );
+  collectGeometries( gridViewB, b );
+
+  if( a.size() != b.size() )
+    DUNE_THROW( Dune::GridError, what << ": Number of coordinates differs." );
+  for( std::size_t i = 0; i < a.size(); ++i )
+  {
+    if( std::abs( a[ i ] - b[ i ] ) > 1e-12 * (1 + std::abs( b[ i ] )) )
+      DUNE_THROW( Dune::GridError, what << ": Coordinates differ." );
+  }
+}
+
+// compare the leaf and all level views of two grids
+template< class GridA, class GridB >
+void compareCoordinates ( const GridA &gridA, const GridB &gridB, const std::string &what )
+{
+  compareGeometries( gridA.leafGridView(), gridB.leafGridView(), what );
+  for( int level = 0; level <= gridA.maxLevel(); ++level )
+    compareGeometries( gridA.levelGridView( level ), gridB.levelGridView( level ), what );
+}
+
+// cached coordinates (serially and in parallel evaluated) have to equal
+// the ones obtained from the analytical coordinate function
+template< class GeometryGridType >
+void checkCachedCoordinates ( GeometryGridType &geogrid )
+{
+  typedef typename GeometryGridType::HostGrid HostGrid;
+
+  AnalyticalCoordFunction analytical;
+  Dune::GeometryGrid< HostGrid, AnalyticalCoordFunction > uncached( geogrid.hostGrid(), analytical );
+  compareCoordinates( geogrid, uncached, "Cached coordinate function" );
+
+  CoordFunction parallel( geogrid.hostGrid(), analytical, true );
+  Dune::GeometryGrid< HostGrid, CoordFunction > parallelGrid( geogrid.hostGrid(), parallel );
+  compareCoordinates( parallelGrid, uncached, "Cached coordinate function (parallel evaluation)" );
+}
+#endif // #if CACHECOORDFUNCTION
+
 template <class GeometryGridType>
 void test(const std::string& gridfile)
 {
@@ -113,6 +210,13 @@ void test(const std::string& gridfile)
       checkCommunication( geogrid, i, std::cout );
   }
 
+  std::cerr << "Checking geometry cache..." << std::endl;
+  checkGeometryCache( geogrid );
+
+#if CACHECOORDFUNCTION
+  std::cerr << "Checking cached coordinates..." << std::endl;
+  checkCachedCoordinates( geogrid );
+#endif // #if CACHECOORDFUNCTION
 }
 
 int main ( int argc, char **argv )
@@ -137,6 +137,10 @@ void testOneDGrid(OneDGrid& grid)
   // check macro grid
   gridcheck(grid);
 
+  // uniform refinement of a uniform grid takes a shortcut
+  grid.globalRefine(1);
+  gridcheck(grid);
+
   // create hybrid grid
   grid.mark(1, * grid.leafbegin<0>());
   grid.preAdapt();
@@ -150,6 +154,11 @@ void testOneDGrid(OneDGrid& grid)
   grid.globalRefine(1);
   gridcheck(grid);
 
+  // relocate the entities into iteration order and check again
+  grid.compactStorage();
+  gridcheck(grid);
+  checkIntersectionIterator(grid);
+
   // check geometry lifetime
   checkGeometryLifetime( grid.leafGridView() );
 
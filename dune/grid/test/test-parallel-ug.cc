@@ -16,6 +16,7 @@
 #include <dune/common/float_cmp.hh>
 #include <dune/grid/common/gridenums.hh>
 #include <dune/grid/utility/structuredgridfactory.hh>
+#include <dune/grid/utility/gridpartitioner.hh>
 #include <dune/geometry/referenceelements.hh>
 
 using namespace Dune;
@@ -442,7 +443,7 @@ class LoadBalance
 
 public:
   template <class Grid>
-  static void test(Grid& grid)
+  static void test(Grid& grid, bool weighted = false)
   {
 #if !HAVE_UG_PATCH10
     grid.loadBalance();
@@ -471,7 +472,18 @@ public:
 
     // balance the grid and the data
     LBDataHandle<Grid, std::vector<Position>, commCodim> dataHandle(grid, dataVector);
-    grid.loadBalance(dataHandle);
+    if (weighted) {
+      // weight the elements by their x-coordinate to obtain an uneven distribution
+      std::vector<double> elementWeights(gv.size(0));
+      typedef typename LeafGV::template Codim<0>::Iterator ElementIterator;
+      const ElementIterator eEndIt = gv.template end<0>();
+      for (ElementIterator eIt = gv.template begin<0>(); eIt != eEndIt; ++eIt)
+        elementWeights[gv.indexSet().index(*eIt)] = 1.0 + eIt->geometry().center()[0];
+
+      grid.loadBalance(elementWeights, dataHandle);
+    }
+    else
+      grid.loadBalance(dataHandle);
 
     // check for correctness
     it = gv.template begin<commCodim, Dune::InteriorBorder_Partition>();
@@ -523,6 +535,17 @@ void testParallelUG(bool localRefinement)
   //////////////////////////////////////////////////////
   LoadBalance::test(*grid);
 
+  // Redistribute according to element weights
+  LoadBalance::test(*grid, true);
+
+  // Redistribute according to a partition computed by the GridPartitioner
+  {
+    GridPartitioner<typename GridType::LeafGridView> partitioner(grid->leafGridView());
+    std::vector<int> targets;
+    partitioner.partition(targets);
+    grid->loadBalance(targets, 0);
+  }
+
   std::cout << "Process " << grid->comm().rank() + 1
             << " has " << grid->size(0)
             << " elements and " << grid->size(dim)
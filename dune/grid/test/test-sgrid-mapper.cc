@@ -0,0 +1,154 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test and benchmark for subentity indices of SGrid, compared to YaspGrid
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/sgrid.hh>
+#include <dune/grid/yaspgrid.hh>
+
+using namespace Dune;
+
+// layout for the faces (codimension 1) of a grid
+template< int dim >
+struct MCMGFaceLayout
+{
+  bool contains ( GeometryType gt ) const { return gt.dim() == dim-1; }
+};
+
+// check that the subentity indices of the faces match the faces' geometries
+template< class GridView >
+bool checkFaces ( const GridView &view )
+{
+  typedef typename GridView::ctype ctype;
+  const int dim = GridView::dimension;
+  typedef typename GridView::template Codim< 0 >::Iterator ElementIterator;
+  typedef typename GridView::template Codim< 1 >::EntityPointer FacePointer;
+  typedef typename GridView::template Codim< 0 >::Geometry::GlobalCoordinate GlobalCoordinate;
+
+  const typename GridView::IndexSet &indexSet = view.indexSet();
+  std::vector< int > visits( indexSet.size( 1 ), 0 );
+
+  const ElementIterator end = view.template end< 0 >();
+  for( ElementIterator it = view.template begin< 0 >(); it != end; ++it )
+  {
+    const ReferenceElement< ctype, dim > &refElement
+      = ReferenceElements< ctype, dim >::general( it->type() );
+    for( int i = 0; i < refElement.size( 1 ); ++i )
+    {
+      const int index = indexSet.subIndex( *it, i, 1 );
+      const FacePointer face = it->template subEntity< 1 >( i );
+      if( index != indexSet.index( *face ) )
+      {
+        std::cout << "ERROR: subIndex does not match index of subentity " << i << std::endl;
+        return false;
+      }
+
+      GlobalCoordinate diff = face->geometry().center();
+      diff -= it->geometry().global( refElement.position( i, 1 ) );
+      if( diff.two_norm() > 1e-8 )
+      {
+        std::cout << "ERROR: subentity " << i << " is not the face " << i << " of its element" << std::endl;
+        return false;
+      }
+      ++visits[ index ];
+    }
+  }
+
+  // each face is shared by one or two elements
+  for( std::size_t index = 0; index < visits.size(); ++index )
+  {
+    if( (visits[ index ] < 1) || (visits[ index ] > 2) )
+    {
+      std::cout << "ERROR: face " << index << " visited " << visits[ index ] << " times" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// look up the faces of all elements through a mapper and return the time per lookup
+template< class GridView >
+double benchmark ( const GridView &view, int sweeps )
+{
+  const int dim = GridView::dimension;
+  typedef typename GridView::template Codim< 0 >::Iterator ElementIterator;
+  typedef MultipleCodimMultipleGeomTypeMapper< GridView, MCMGFaceLayout > Mapper;
+
+  const Mapper mapper( view );
+  std::vector< double > data( mapper.size(), 1.0 );
+
+  Timer timer;
+  double sum = 0.0;
+  std::size_t lookups = 0;
+  const ElementIterator end = view.template end< 0 >();
+  for( int sweep = 0; sweep < sweeps; ++sweep )
+  {
+    for( ElementIterator it = view.template begin< 0 >(); it != end; ++it )
+    {
+      for( int i = 0; i < 2*dim; ++i )
+        sum += data[ mapper.map( *it, i, 1 ) ];
+      lookups += 2*dim;
+    }
+  }
+  const double time = timer.elapsed();
+
+  // use the result, so the lookups cannot be optimized away
+  if( sum != double( lookups ) )
+    std::cout << "ERROR: wrong sum of face data" << std::endl;
+  return (lookups > 0 ? time / lookups : 0.0);
+}
+
+template< int dim >
+bool test ( int n, int sweeps )
+{
+  bool ret = true;
+
+  SGrid< dim, dim > sgrid( FieldVector< int, dim >( n ), FieldVector< double, dim >( 0.0 ), FieldVector< double, dim >( 1.0 ) );
+
+  FieldVector< double, dim > Len( 1.0 );
+  Dune::array< int, dim > s;
+  std::fill( s.begin(), s.end(), n );
+  std::bitset< dim > p;
+  const YaspGrid< dim > yaspgrid( Len, s, p, 0 );
+
+  ret &= checkFaces( sgrid.leafView() );
+  ret &= checkFaces( sgrid.levelView( 0 ) );
+
+  const double stime = benchmark( sgrid.leafView(), sweeps );
+  const double ytime = benchmark( yaspgrid.leafView(), sweeps );
+  std::cout << "face lookups on " << n << "^" << dim << " elements: "
+            << "SGrid " << stime*1e9 << "ns, YaspGrid " << ytime*1e9 << "ns" << std::endl;
+
+  return ret;
+}
+
+int main ( int argc, char **argv )
+try {
+
+  // this method calls MPI_Init, if MPI is enabled
+  MPIHelper::instance( argc, argv );
+
+  bool ret = true;
+  ret &= test< 2 >( 256, 5 );
+  ret &= test< 3 >( 40, 5 );
+  return (ret ? 0 : 1);
+
+}
+catch (Exception &e) {
+  std::cerr << e << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
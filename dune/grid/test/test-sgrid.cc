@@ -9,6 +9,7 @@
 #include <dune/grid/sgrid.hh>
 
 #include "gridcheck.cc"
+#include "checkbatchedgeometry.cc"
 #include "checkgeometryinfather.cc"
 #include "checkintersectionit.cc"
 #include "checkpartition.cc"
@@ -27,6 +28,10 @@ void runtest()
   checkGeometryInFather(g);
   checkIntersectionIterator(g);
   checkPartitionType( g.leafView() );
+  // check the batched evaluation of the geometries
+  checkBatchedGeometry<0>( g.leafView() );
+  checkBatchedGeometry<1>( g.leafView() );
+  checkBatchedGeometry<d>( g.leafView() );
   // check geometry lifetime
   checkGeometryLifetime( g.leafView() );
 
@@ -0,0 +1,178 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test and benchmark for the blocked traversal of YaspGrid
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+#include <dune/grid/yaspgrid.hh>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Dune;
+
+// apply a (2*dim+1)-point Laplacian to all cells with all neighbors on this process
+template< class Stencil, class Iterator >
+void laplace ( const Stencil &stencil, Iterator it, const Iterator &end,
+               const std::vector< double > &u, std::vector< double > &v )
+{
+  const int dim = Stencil::dim;
+  for( ; it != end; ++it )
+  {
+    bool inner = true;
+    for( int i = 0; i < dim; ++i )
+      inner &= (it.coord( i ) > stencil.origin( i )) && (it.coord( i ) < stencil.origin( i ) + stencil.extent( i )-1);
+    if( !inner )
+      continue;
+
+    const int index = it.superindex();
+    double value = -2*dim*u[ index ];
+    for( int i = 0; i < dim; ++i )
+      value += u[ index - stencil.stride( i ) ] + u[ index + stencil.stride( i ) ];
+    v[ index ] = value;
+  }
+}
+
+// check that a traversal visits every cell exactly once
+template< class Stencil, class Iterator >
+bool checkTraversal ( const Stencil &stencil, Iterator it, const Iterator &end )
+{
+  std::vector< int > visits( stencil.size(), 0 );
+  for( ; it != end; ++it )
+  {
+    if( stencil.index( it.coord() ) != it.superindex() )
+    {
+      std::cout << "ERROR: coordinate does not match index " << it.superindex() << std::endl;
+      return false;
+    }
+    ++visits[ it.superindex() ];
+  }
+  for( int index = 0; index < stencil.size(); ++index )
+  {
+    if( visits[ index ] != 1 )
+    {
+      std::cout << "ERROR: cell " << index << " visited " << visits[ index ] << " times" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template< int dim >
+bool test ( int n, int tile, int sweeps )
+{
+  typedef YaspGrid< dim > Grid;
+  typedef YaspStencil< const Grid > Stencil;
+  typedef typename Stencil::iTupel iTupel;
+
+  FieldVector< double, dim > Len( 1.0 );
+  Dune::array< int, dim > s;
+  std::fill( s.begin(), s.end(), n );
+  std::bitset< dim > p;
+  const Grid grid( Len, s, p, 0 );
+
+  const Stencil stencil = grid.leafStencil();
+  std::cout << "YaspGrid<" << dim << "> with " << stencil.size() << " cells:" << std::endl;
+
+  bool ret = true;
+
+  // tiles of one cell and a single tile covering the grid both yield the lexicographic order
+  const iTupel one( 1 ), large( n+1 ), tiles( tile );
+  ret &= checkTraversal( stencil, stencil.tiledBegin( one ), stencil.tiledEnd() );
+  ret &= checkTraversal( stencil, stencil.tiledBegin( large ), stencil.tiledEnd() );
+  ret &= checkTraversal( stencil, stencil.tiledBegin( tiles ), stencil.tiledEnd() );
+  ret &= checkTraversal( stencil, stencil.tiledBegin( tiles, true ), stencil.tiledEnd() );
+  iTupel uneven( tile );
+  uneven[ 0 ] = 3;
+  ret &= checkTraversal( stencil, stencil.tiledBegin( uneven, true ), stencil.tiledEnd() );
+
+  std::vector< double > u( stencil.size() );
+  for( int index = 0; index < stencil.size(); ++index )
+    u[ index ] = std::sin( double( index ) );
+
+  const char *names[ 3 ] = { "lexicographic", "tiled", "Morton tiled" };
+  std::vector< double > v[ 3 ];
+  for( int order = 0; order < 3; ++order )
+  {
+    v[ order ].assign( stencil.size(), 0.0 );
+
+    Timer timer;
+    for( int sweep = 0; sweep < sweeps; ++sweep )
+    {
+      if( order == 0 )
+        laplace( stencil, stencil.tiledBegin( large ), stencil.tiledEnd(), u, v[ order ] );
+      else
+        laplace( stencil, stencil.tiledBegin( tiles, order == 2 ), stencil.tiledEnd(), u, v[ order ] );
+    }
+    const double time = timer.elapsed();
+    std::cout << "  " << names[ order ] << ": " << time << "s ("
+              << (time > 0.0 ? double( sweeps ) * stencil.size() / time : 0.0) << " cells/s)" << std::endl;
+
+    if( v[ order ] != v[ 0 ] )
+    {
+      std::cout << "ERROR: " << names[ order ] << " traversal yields a different result" << std::endl;
+      ret = false;
+    }
+  }
+
+#ifdef _OPENMP
+  // sweep over thread boxes, each traversed in tiled order
+  typedef YaspThreadPartition< const Grid > Partition;
+  typedef typename Partition::Box Box;
+  const Partition partition( grid, grid.maxLevel(), omp_get_max_threads() );
+
+  std::vector< double > w( stencil.size(), 0.0 );
+  Timer timer;
+  for( int sweep = 0; sweep < sweeps; ++sweep )
+  {
+#pragma omp parallel for
+    for( int t = 0; t < partition.size(); ++t )
+    {
+      const Box &box = partition.box( t );
+      if( !box.empty() )
+        laplace( stencil, box.tiledsubbegin( tiles ), typename Box::TiledSubIterator( box.subend() ), u, w );
+    }
+  }
+  const double time = timer.elapsed();
+  std::cout << "  " << partition.size() << " thread boxes: " << time << "s ("
+            << (time > 0.0 ? double( sweeps ) * stencil.size() / time : 0.0) << " cells/s)" << std::endl;
+
+  if( w != v[ 0 ] )
+  {
+    std::cout << "ERROR: threaded traversal yields a different result" << std::endl;
+    ret = false;
+  }
+#endif // #ifdef _OPENMP
+
+  return ret;
+}
+
+int main ( int argc, char **argv )
+try {
+
+  // this method calls MPI_Init, if MPI is enabled
+  MPIHelper::instance( argc, argv );
+
+  bool ret = true;
+  ret &= test< 2 >( 512, 32, 10 );
+  ret &= test< 3 >( 96, 16, 10 );
+  return (ret ? 0 : 1);
+
+}
+catch (Exception &e) {
+  std::cerr << e << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
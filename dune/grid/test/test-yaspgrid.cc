@@ -4,6 +4,8 @@
 
 #include <config.h>
 
+#include <bitset>
+#include <cmath>
 #include <iostream>
 
 #include <dune/grid/yaspgrid.hh>
@@ -13,10 +15,171 @@
 #include "checkgeometryinfather.cc"
 #include "checkintersectionit.cc"
 #include "checkadaptation.cc"
+#include "checkbatchedgeometry.cc"
 #include "checkpartition.cc"
 
 int rank;
 
+// compare the structured stencil with the intersection iterator and the index set
+template <int dim>
+void checkStencil (const Dune::YaspGrid<dim>& grid)
+{
+  typedef Dune::YaspGrid<dim> Grid;
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim<0>::Iterator Iterator;
+  typedef typename GridView::IntersectionIterator IntersectionIterator;
+
+  const GridView view = grid.leafView();
+  const Dune::YaspStencil<const Grid> stencil = grid.leafStencil();
+
+  if (stencil.size() != view.indexSet().size(0))
+    DUNE_THROW(Dune::GridError, "YaspStencil: wrong number of cells");
+
+  const Iterator end = view.template end<0>();
+  for (Iterator it = view.template begin<0>(); it != end; ++it)
+  {
+    const int index = view.indexSet().index(*it);
+    if (stencil.index(stencil.coord(index)) != index)
+      DUNE_THROW(Dune::GridError, "YaspStencil: coordinate does not match index");
+
+    for (int c = 0; c < it->template count<dim>(); ++c)
+    {
+      if (stencil.vertex(index, c) != int(view.indexSet().subIndex(*it, c, dim)))
+        DUNE_THROW(Dune::GridError, "YaspStencil: wrong vertex index");
+    }
+
+    const IntersectionIterator iend = view.iend(*it);
+    for (IntersectionIterator iit = view.ibegin(*it); iit != iend; ++iit)
+    {
+      const int face = iit->indexInInside();
+      if (stencil.boundary(index, face) != iit->boundary())
+        DUNE_THROW(Dune::GridError, "YaspStencil: wrong boundary flag");
+      if (iit->neighbor())
+      {
+        const int neighbor = view.indexSet().index(*iit->outside());
+        if (stencil.neighbor(index, face) != neighbor)
+          DUNE_THROW(Dune::GridError, "YaspStencil: wrong neighbor index");
+      }
+      else if (!grid.isPeriodic(face/2) && stencil.neighbor(index, face) != stencil.invalid)
+        DUNE_THROW(Dune::GridError, "YaspStencil: neighbor should not exist");
+    }
+  }
+}
+
+// check that the thread boxes cover all interior cells exactly once
+template <int dim>
+void checkThreadPartition (const Dune::YaspGrid<dim>& grid)
+{
+  typedef Dune::YaspThreadPartition<const Dune::YaspGrid<dim> > Partition;
+  typedef typename Partition::Box Box;
+
+  const int level = grid.maxLevel();
+  const int interior = grid.begin(level)->cell_interior.totalsize();
+  for (int numThreads = 1; numThreads <= 6; ++numThreads)
+  {
+    const Partition partition(grid, level, numThreads);
+    if (partition.size() != numThreads)
+      DUNE_THROW(Dune::GridError, "YaspThreadPartition: wrong number of boxes");
+
+    std::vector<int> visits(grid.levelIndexSet(level).size(0), 0);
+    for (int t = 0; t < partition.size(); ++t)
+    {
+      const Box& box = partition.box(t);
+      if (box.empty())
+        continue;
+      for (typename Box::SubIterator it = box.subbegin(); it != box.subend(); ++it)
+        ++visits[it.superindex()];
+    }
+
+    int visited = 0;
+    for (std::size_t i = 0; i < visits.size(); ++i)
+    {
+      if (visits[i] > 1)
+        DUNE_THROW(Dune::GridError, "YaspThreadPartition: cell in several boxes");
+      visited += visits[i];
+    }
+    if (visited != interior)
+      DUNE_THROW(Dune::GridError, "YaspThreadPartition: boxes do not cover the interior cells");
+  }
+}
+
+// compare the estimated cost of a decomposition with the expected value
+void checkLoadBalanceCost (const Dune::YLoadBalanceSurface<3>& lb, const Dune::FieldVector<int,3>& size,
+                           const Dune::FieldVector<int,3>& dims, double expected, const char* name)
+{
+  const double cost = lb.cost(size, dims);
+  if (std::abs(cost - expected) > 1e-8*expected)
+    DUNE_THROW(Dune::GridError, "YLoadBalanceSurface: cost (" << name << ") is " << cost
+               << ", expected " << expected);
+}
+
+// check the communication aware load balancer
+void checkLoadBalance ()
+{
+  typedef Dune::FieldVector<int,3> iTupel;
+  const iTupel size(64);
+  const Dune::YLoadBalanceSurface<3> lb;
+
+  for (int P = 1; P <= 24; ++P)
+  {
+    iTupel dims;
+    lb.loadbalance(size, P, dims);
+    if (dims[0]*dims[1]*dims[2] != P)
+      DUNE_THROW(Dune::GridError, "YLoadBalanceSurface: wrong number of processes");
+  }
+
+  iTupel dims;
+  lb.loadbalance(size, 8, dims);
+  if (dims != iTupel(2))
+    DUNE_THROW(Dune::GridError, "YLoadBalanceSurface: expected 2x2x2 processes");
+
+  // only tensor product decompositions are possible, so a prime number of
+  // processes yields a slab decomposition
+  lb.loadbalance(size, 7, dims);
+  if (dims[0]*dims[1]*dims[2] != 7 || std::max(dims[0], std::max(dims[1], dims[2])) != 7)
+    DUNE_THROW(Dune::GridError, "YLoadBalanceSurface: expected a 7x1x1 decomposition");
+
+  // 2x2x2 processes: 32^3 cells per process, one face neighbor per direction
+  const iTupel cube(2);
+  checkLoadBalanceCost(lb, size, cube, 32768.0 + 3*1024.0, "default");
+
+  // the halo grows with the overlap width
+  const Dune::YLoadBalanceSurface<3> lbOverlap(2);
+  checkLoadBalanceCost(lbOverlap, size, cube, 32768.0 + 2*3*1024.0, "overlap");
+
+  // periodic directions have two face neighbors
+  std::bitset<3> periodic;
+  periodic[0] = true;
+  const Dune::YLoadBalanceSurface<3> lbPeriodic(1, periodic);
+  checkLoadBalanceCost(lbPeriodic, size, cube, 32768.0 + 4*1024.0, "periodic");
+
+  // processes at non-periodic boundaries of an 8x1x1 slab have fewer neighbors
+  iTupel slab(1);
+  slab[0] = 8;
+  checkLoadBalanceCost(lb, size, slab, 32768.0 + 2*4096.0, "slab");
+  // a periodic direction with a single process exchanges with itself
+  std::bitset<3> periodicSlab;
+  periodicSlab[1] = true;
+  const Dune::YLoadBalanceSurface<3> lbPeriodicSlab(1, periodicSlab);
+  checkLoadBalanceCost(lbPeriodicSlab, size, slab, 32768.0 + 2*4096.0 + 2*512.0, "periodic slab");
+
+  // a node holding all processes has no inter-node halo
+  const Dune::YLoadBalanceSurface<3> lbNode8(1, std::bitset<3>(), 8);
+  checkLoadBalanceCost(lbNode8, size, cube, 32768.0 + 3*1024.0, "8 ranks per node");
+
+  // two ranks per node form 64x32x32 blocks in a 1x2x2 torus of nodes;
+  // their halo of 2*2048 cells is shared by both ranks and weighted by 4
+  const Dune::YLoadBalanceSurface<3> lbNode2(1, std::bitset<3>(), 2);
+  checkLoadBalanceCost(lbNode2, size, cube, 32768.0 + 3*1024.0 + 4*2048.0, "2 ranks per node");
+
+  // ...and the inter-node halo prefers keeping heavy neighbors on one node
+  lbNode2.loadbalance(size, 8, dims);
+  if (dims[0]*dims[1]*dims[2] != 8)
+    DUNE_THROW(Dune::GridError, "YLoadBalanceSurface: wrong number of processes (2 ranks per node)");
+  if (lbNode2.cost(size, dims) > lbNode2.cost(size, cube))
+    DUNE_THROW(Dune::GridError, "YLoadBalanceSurface: decomposition is not optimal (2 ranks per node)");
+}
+
 template <int dim>
 void check_yasp(bool p0=false) {
   typedef Dune::FieldVector<double,dim> fTupel;
@@ -50,6 +213,15 @@ void check_yasp(bool p0=false) {
   for(int l=0; l<=grid.maxLevel(); ++l)
     checkCommunication(grid,l,Dune::dvverb);
 
+  // check communication with messages to processes on the same node passed through shared memory
+  grid.sharedMemoryExchange(true);
+  checkCommunication(grid,-1,Dune::dvverb);
+  grid.sharedMemoryExchange(false);
+
+  // report the memory used by the level descriptions and their communication interfaces
+  if (rank == 0)
+    grid.printMemoryReport(std::cout);
+
   // check geometry lifetime
   checkGeometryLifetime( grid.leafView() );
   // check the method geometryInFather()
@@ -59,6 +231,13 @@ void check_yasp(bool p0=false) {
   // check grid adaptation interface
   checkAdaptRefinement(grid);
   checkPartitionType( grid.leafView() );
+  // check the batched evaluation of the geometries
+  checkBatchedGeometry<0>( grid.leafView() );
+  checkBatchedGeometry<dim>( grid.leafView() );
+  // check the structured stencil
+  checkStencil(grid);
+  // check the decomposition into thread boxes
+  checkThreadPartition(grid);
 
   // test operator<<
   std::cout << grid << std::endl;
@@ -74,6 +253,8 @@ int main (int argc , char **argv) {
     MPI_Comm_rank(MPI_COMM_WORLD,&rank);
 #endif
 
+    checkLoadBalance();
+
     check_yasp<1>();
     //check_yasp<1>(true);
     check_yasp<2>();
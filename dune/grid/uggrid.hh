@@ -17,6 +17,7 @@
 #include <dune/grid/common/boundarysegment.hh>
 #include <dune/grid/common/capabilities.hh>
 #include <dune/grid/common/grid.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 
 #if HAVE_UG || DOXYGEN
 
@@ -462,6 +463,20 @@ namespace Dune {
 
     /** \brief Clean up refinement markers */
     void postAdapt();
+
+    /** \brief Obtain counters and timers of the adaptation process
+
+       UG does not report the number of refined and coarsened elements,
+       so only the change of the number of leaf elements is recorded.
+     */
+    const AdaptationStatistics &adaptationStatistics() const {
+      return adaptationStatistics_;
+    }
+
+    /** \brief Obtain counters and timers of the adaptation process (e.g., to reset them) */
+    AdaptationStatistics &adaptationStatistics() {
+      return adaptationStatistics_;
+    }
     /*@}*/
 
     /** \brief Size of the overlap on the leaf level */
@@ -529,6 +544,47 @@ namespace Dune {
 #endif  // HAVE_UG_PATCH10
     }
 
+    /** \brief Distributes the grid according to element weights and migrates data in the same pass
+
+        The macro elements are cut into consecutive pieces of (nearly) equal weight,
+        one for each process.  The weight of a macro element is the sum of the weights
+        of all its leaf descendants.  Each macro element is sent to its new process
+        together with all its descendants, and the data attached by the data handle
+        travels along.
+
+        \tparam DataHandle works like the data handle for the communicate
+        methods.
+
+        \param elementWeights Weight (e.g., computational cost) of each leaf element,
+        indexed by the leaf index set.  Only the weights of interior elements are used.
+        \param dataHandle Data handle gathering and scattering the data to migrate
+
+        \return True, if grid has changed, false otherwise
+     */
+    template<class DataHandle>
+    bool loadBalance (const std::vector<double>& elementWeights, DataHandle& dataHandle)
+    {
+#if !HAVE_UG_PATCH10
+      DUNE_THROW(NotImplemented, "load balancing with data attached");
+#else
+#ifdef ModelP
+      // gather node data
+      UGLBGatherScatter::template gather<dim>(this->leafView(), dataHandle);
+#endif
+
+      // the load balancing step now also attaches
+      // the data to the entities and distributes it
+      loadBalanceWithWeights(elementWeights);
+
+#ifdef ModelP
+      // scatter node data
+      UGLBGatherScatter::template scatter<dim>(this->leafView(), dataHandle);
+#endif
+
+      return true;
+#endif  // HAVE_UG_PATCH10
+    }
+
     /** \brief Distributes this grid over the available nodes in a distributed machine
 
        If you want the UG default for the parameters pick
@@ -547,6 +603,21 @@ namespace Dune {
      */
     bool loadBalance(int strategy, int minlevel, int depth, int maxlevel, int minelement);
 
+    /** \brief Distributes this grid according to a prescribed partition
+
+        This method allows to use an external partitioner, e.g., the GridPartitioner.
+        The elements on level fromLevel are sent to their new processes together with
+        all their descendants.  Each of these trees goes to the process that most of
+        its leaf elements are assigned to.
+
+        \param targetProcessors New process of each leaf element, indexed by the leaf
+        index set.  Only the entries of interior elements are used.
+        \param fromLevel The coarsest grid level that gets distributed
+
+        \return True, if grid has changed, false otherwise
+     */
+    bool loadBalance(const std::vector<int>& targetProcessors, unsigned int fromLevel);
+
     /** \brief The communication interface for all codims on a given level
        @param dataHandle type used to gather/scatter data in and out of the message buffer
        @param iftype one of the predifined interface types, throws error if it is not implemented
@@ -849,6 +920,17 @@ namespace Dune {
     void setIndices(bool setLevelZero,
                     std::vector<unsigned int>* nodePermutation);
 
+    /** \brief Distributes the macro elements and their descendants according to leaf element weights
+        \param elementWeights Weight of each leaf element, indexed by the leaf index set
+     */
+    void loadBalanceWithWeights(const std::vector<double>& elementWeights);
+
+    /** \brief Sends the interior elements of a level and all their descendants to new processes
+        \param rootTargets New process of each element on level fromLevel, indexed by the level index set
+        \param fromLevel Level of the roots of the trees to send
+     */
+    void transferTrees(const std::vector<int>& rootTargets, unsigned int fromLevel);
+
     // Each UGGrid object has a unique name to identify it in the
     // UG environment structure
     std::string name_;
@@ -891,6 +973,9 @@ namespace Dune {
      */
     bool someElementHasBeenMarkedForCoarsening_;
 
+    /** \brief Counters and timers of the adaptation process */
+    AdaptationStatistics adaptationStatistics_;
+
     /** \brief The size of UG's internal heap in megabytes
      *
      * It is handed over to UG for each new multigrid.
@@ -3,7 +3,10 @@
 
 #include <config.h>
 
+#include <algorithm>
+#include <map>
 #include <set>
+#include <vector>
 
 #include <dune/grid/uggrid.hh>
 
@@ -249,6 +252,7 @@ bool Dune::UGGrid < dim >::mark(int refCount,
         ) DUNE_THROW(GridError, "UG" << dim << "d::MarkForRefinement returned error code!");
 
     someElementHasBeenMarkedForRefinement_ = true;
+    AdaptationStatistics::count(adaptationStatistics_.markedForRefinement);
     return true;
   } else if (refCount==-1) {
 
@@ -258,6 +262,7 @@ bool Dune::UGGrid < dim >::mark(int refCount,
         ) DUNE_THROW(GridError, "UG" << dim << "d::MarkForRefinement returned error code!");
 
     someElementHasBeenMarkedForCoarsening_ = true;
+    AdaptationStatistics::count(adaptationStatistics_.markedForCoarsening);
     return true;
   } else
     DUNE_THROW(GridError, "UGGrid only supports refCount values -1, 0, and 1 for mark()!");
@@ -275,6 +280,7 @@ bool Dune::UGGrid < dim >::mark(const typename Traits::template Codim<0>::Entity
     return false;
 
   someElementHasBeenMarkedForRefinement_ = true;
+  AdaptationStatistics::count(adaptationStatistics_.markedForRefinement);
 
   return UG_NS<dim>::MarkForRefinement(target, rule, side);
 
@@ -307,6 +313,8 @@ int Dune::UGGrid<dim>::getMark(const typename Traits::template Codim<0>::Entity&
 template <int dim>
 bool Dune::UGGrid <dim>::preAdapt()
 {
+  AdaptationStatistics::Timer timer(adaptationStatistics_.preAdaptTime);
+
   if( closureType_ == GREEN )
   {
     // when conforming refinement is enabled
@@ -328,6 +336,10 @@ bool Dune::UGGrid < dim >::adapt()
 {
   assert(multigrid_);
 
+  AdaptationStatistics::Timer timer(adaptationStatistics_.adaptTime);
+  AdaptationStatistics::count(adaptationStatistics_.adaptCalls);
+  const int oldSize = leafIndexSet().size(0);
+
   // Set UG's currBVP variable to the BVP corresponding to this
   // grid.  This is necessary if we have more than one UGGrid in use.
   UG_NS<dim>::Set_Current_BVP(multigrid_->theBVP);
@@ -352,7 +364,12 @@ bool Dune::UGGrid < dim >::adapt()
     DUNE_THROW(GridError, "UG::adapt() returned with error code " << rv);
 
   // Renumber everything
-  setIndices(false, NULL);
+  {
+    AdaptationStatistics::Timer indexSetTimer(adaptationStatistics_.indexSetTime);
+    setIndices(false, NULL);
+  }
+
+  adaptationStatistics_.changeElements(oldSize, leafIndexSet().size(0));
 
   // Return true iff the grid hierarchy changed
   //return !(bool)multigrid_->status;
@@ -364,6 +381,8 @@ bool Dune::UGGrid < dim >::adapt()
 template <int dim>
 void Dune::UGGrid <dim>::postAdapt()
 {
+  AdaptationStatistics::Timer timer(adaptationStatistics_.postAdaptTime);
+
   for (int i=0; i<=maxLevel(); i++) {
 
     typename Traits::template Codim<0>::LevelIterator eIt    = lbegin<0>(i);
@@ -382,6 +401,8 @@ void Dune::UGGrid <dim>::postAdapt()
 template < int dim >
 void Dune::UGGrid < dim >::globalRefine(int n)
 {
+  AdaptationStatistics::Timer timer(adaptationStatistics_.globalRefineTime);
+
   for (int i=0; i<n; i++) {
 
     // mark all entities for grid refinement
@@ -544,6 +565,156 @@ bool Dune::UGGrid < dim >::loadBalance(int strategy, int minlevel, int depth, in
   return true;
 }
 
+template < int dim >
+bool Dune::UGGrid < dim >::loadBalance(const std::vector<int>& targetProcessors, unsigned int fromLevel)
+{
+  // Do nothing if we are on a single process
+  if (comm().size()==1)
+    return true;
+
+#ifdef ModelP
+  typedef typename Traits::template Codim<0>::LevelIterator LevelIterator;
+  typedef typename Traits::HierarchicIterator HierarchicIterator;
+
+  assert(targetProcessors.size() == leafIndexSet().size(0));
+  assert(int(fromLevel) <= maxLevel());
+
+  // Each tree is sent to the process most of its leaf elements are assigned to
+  std::vector<int> rootTargets(levelIndexSet(fromLevel).size(0), comm().rank());
+
+  const LevelIterator endIt = lend<0>(fromLevel);
+  for (LevelIterator it = lbegin<0>(fromLevel); it != endIt; ++it) {
+
+    if (it->partitionType() != InteriorEntity)
+      continue;
+
+    std::map<int, std::size_t> count;
+    if (it->isLeaf())
+      ++count[targetProcessors[leafIndexSet().index(*it)]];
+
+    const HierarchicIterator hEndIt = it->hend(maxLevel());
+    for (HierarchicIterator hIt = it->hbegin(maxLevel()); hIt != hEndIt; ++hIt)
+      if (hIt->isLeaf())
+        ++count[targetProcessors[leafIndexSet().index(*hIt)]];
+
+    int& target = rootTargets[levelIndexSet(fromLevel).index(*it)];
+    std::size_t maxCount = 0;
+    for (std::map<int, std::size_t>::const_iterator cIt = count.begin(); cIt != count.end(); ++cIt) {
+      if (cIt->second > maxCount) {
+        target = cIt->first;
+        maxCount = cIt->second;
+      }
+    }
+  }
+
+  transferTrees(rootTargets, fromLevel);
+#endif
+
+  return true;
+}
+
+template < int dim >
+void Dune::UGGrid < dim >::loadBalanceWithWeights(const std::vector<double>& elementWeights)
+{
+  // Do nothing if we are on a single process
+  if (comm().size()==1)
+    return;
+
+#ifdef ModelP
+  typedef typename Traits::template Codim<0>::LevelIterator LevelIterator;
+  typedef typename Traits::HierarchicIterator HierarchicIterator;
+
+  assert(elementWeights.size() == leafIndexSet().size(0));
+
+  // Sum up the weights of the leaf descendants of each interior macro element
+  std::vector<double> macroWeights(levelIndexSet(0).size(0), 0.0);
+  double localWeight = 0.0;
+
+  const LevelIterator endIt = lend<0>(0);
+  for (LevelIterator it = lbegin<0>(0); it != endIt; ++it) {
+
+    if (it->partitionType() != InteriorEntity)
+      continue;
+
+    double& weight = macroWeights[levelIndexSet(0).index(*it)];
+    if (it->isLeaf())
+      weight = elementWeights[leafIndexSet().index(*it)];
+
+    const HierarchicIterator hEndIt = it->hend(maxLevel());
+    for (HierarchicIterator hIt = it->hbegin(maxLevel()); hIt != hEndIt; ++hIt)
+      if (hIt->isLeaf())
+        weight += elementWeights[leafIndexSet().index(*hIt)];
+
+    localWeight += weight;
+  }
+
+  // The macro elements of all processes, in the order of the ranks, form one sequence.
+  // Compute the weight of the part of this sequence in front of our own elements.
+  const int size = comm().size();
+  std::vector<double> rankWeights(size);
+  comm().allgather(&localWeight, 1, &rankWeights[0]);
+
+  double offset = 0.0;
+  double totalWeight = 0.0;
+  for (int p=0; p<size; p++) {
+    if (p < comm().rank())
+      offset += rankWeights[p];
+    totalWeight += rankWeights[p];
+  }
+
+  if (totalWeight <= 0.0)
+    DUNE_THROW(GridError, "Load balancing requires a positive total element weight");
+
+  // Cut the sequence into pieces of equal weight and assign the macro elements
+  // to the process owning their piece
+  std::vector<int> macroTargets(levelIndexSet(0).size(0), comm().rank());
+  for (LevelIterator it = lbegin<0>(0); it != endIt; ++it) {
+
+    if (it->partitionType() != InteriorEntity)
+      continue;
+
+    const int index = levelIndexSet(0).index(*it);
+    offset += 0.5*macroWeights[index];
+    macroTargets[index] = std::min(int(offset * size / totalWeight), size-1);
+    offset += 0.5*macroWeights[index];
+  }
+
+  transferTrees(macroTargets, 0);
+#endif
+}
+
+template < int dim >
+void Dune::UGGrid < dim >::transferTrees(const std::vector<int>& rootTargets, unsigned int fromLevel)
+{
+#ifdef ModelP
+  typedef typename Traits::template Codim<0>::LevelIterator LevelIterator;
+  typedef typename Traits::HierarchicIterator HierarchicIterator;
+
+  // Write the target processes into the partition fields of the roots and all their descendants
+  const LevelIterator endIt = lend<0>(fromLevel);
+  for (LevelIterator it = lbegin<0>(fromLevel); it != endIt; ++it) {
+
+    if (it->partitionType() != InteriorEntity)
+      continue;
+
+    const int target = rootTargets[levelIndexSet(fromLevel).index(*it)];
+    UG_NS<dim>::Partition(this->getRealImplementation(*it).getTarget()) = target;
+
+    const HierarchicIterator hEndIt = it->hend(maxLevel());
+    for (HierarchicIterator hIt = it->hbegin(maxLevel()); hIt != hEndIt; ++hIt)
+      UG_NS<dim>::Partition(this->getRealImplementation(*hIt).getTarget()) = target;
+  }
+
+  int errCode = UG_NS<dim>::TransferGridFromLevel(multigrid_, fromLevel);
+
+  if (errCode)
+    DUNE_THROW(GridError, "UG" << dim << "d::TransferGridFromLevel returned error code " << errCode);
+
+  // Renumber everything.
+  setIndices(true, NULL);
+#endif
+}
+
 
 template < int dim >
 void Dune::UGGrid < dim >::setPosition(const typename Traits::template Codim<dim>::EntityPointer& e,
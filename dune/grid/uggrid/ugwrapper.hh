@@ -644,6 +644,13 @@ namespace Dune {
     }
 #endif
 
+#ifdef ModelP
+    //! Return the process an element is sent to by TransferGridFromLevel
+    static UG::INT& Partition(UG_NS< UG_DIM >::Element* theElement) {
+      return PARTITION(theElement);
+    }
+#endif
+
     //! Return true if the element is a leaf element
     static bool isLeaf(const UG_NS< UG_DIM >::Element* theElement) {
       using UG ::UINT;
@@ -1019,6 +1026,13 @@ namespace Dune {
       return UG_NAMESPACE ::LBCommand(argc, (char**)argv);
     }
 
+#ifdef ModelP
+    /** \brief Move all elements from the given level on to the process stored in their partition field */
+    static int TransferGridFromLevel(UG_NS< UG_DIM >::MultiGrid* theMG, int level) {
+      return UG_NAMESPACE ::TransferGridFromLevel(theMG, level);
+    }
+#endif
+
     static int ConfigureCommand(int argc, const char** argv) {
       /** \todo Can we remove the cast? */
       return UG_NAMESPACE ::ConfigureCommand(argc, (char**)argv);
@@ -0,0 +1,171 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_BOUNDARYINDEX_HH
+#define DUNE_GRID_UTILITY_BOUNDARYINDEX_HH
+
+/** \file
+ *  \brief precomputed list of the boundary intersections of a GridView
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Dune
+{
+
+  // BoundaryIntersectionIndex
+  // -------------------------
+
+  /** \brief precomputed list of the boundary intersections of a GridView
+   *
+   *  Applying boundary conditions usually requires a full sweep over all
+   *  elements and all of their intersections, although only a small fraction
+   *  of the intersections lie on the domain boundary. This class performs
+   *  such a sweep once and stores, for every boundary intersection, the seed
+   *  of the inside element, the local face number within the inside element
+   *  and the boundary segment index.
+   *
+   *  As in VTK::BoundaryIterator, an intersection is considered a boundary
+   *  intersection if boundary() is true and neighbor() is false, i.e.,
+   *  periodic and processor boundaries are skipped.
+   *
+   *  The entries are stored in the order of the element traversal, so the
+   *  entries belonging to one element are consecutive.
+   *
+   *  \note The index is not updated automatically. Call update() after the
+   *        grid has been modified (adapt() or loadBalance()).
+   *
+   *  \tparam  GV  type of the GridView
+   */
+  template< class GV >
+  class BoundaryIntersectionIndex
+  {
+    typedef BoundaryIntersectionIndex< GV > This;
+
+  public:
+    typedef GV GridView;
+    typedef typename GridView::Grid Grid;
+
+    typedef typename GridView::template Codim< 0 >::Entity Element;
+    typedef typename GridView::template Codim< 0 >::EntityPointer ElementPointer;
+    typedef typename Grid::template Codim< 0 >::EntitySeed ElementSeed;
+
+    typedef typename GridView::Intersection Intersection;
+    typedef typename GridView::IntersectionIterator IntersectionIterator;
+
+    /** \brief information stored for each boundary intersection */
+    struct Entry
+    {
+      Entry ( const ElementSeed &seed, int indexInInside, std::size_t boundarySegmentIndex )
+        : seed( seed ), indexInInside( indexInInside ), boundarySegmentIndex( boundarySegmentIndex )
+      {}
+
+      //! seed of the inside element
+      ElementSeed seed;
+      //! local number of the face within the inside element
+      int indexInInside;
+      //! index of the boundary segment, see Intersection::boundarySegmentIndex()
+      std::size_t boundarySegmentIndex;
+    };
+
+  private:
+    typedef std::vector< Entry > EntryVector;
+
+  public:
+    typedef typename EntryVector::size_type Size;
+    typedef typename EntryVector::const_iterator Iterator;
+
+    /** \brief construct the boundary index for a grid view
+     *
+     *  \param[in]  gridView  grid view to extract the boundary intersections from
+     */
+    explicit BoundaryIntersectionIndex ( const GridView &gridView )
+      : gridView_( gridView )
+    {
+      update();
+    }
+
+    /** \brief rebuild the boundary index
+     *
+     *  This method has to be called after the grid was modified, e.g., by
+     *  adapt() or loadBalance().
+     */
+    void update ()
+    {
+      entries_.clear();
+
+      typedef typename GridView::template Codim< 0 >::Iterator ElementIterator;
+      const ElementIterator end = gridView_.template end< 0 >();
+      for( ElementIterator it = gridView_.template begin< 0 >(); it != end; ++it )
+      {
+        const Element &element = *it;
+        if( !element.hasBoundaryIntersections() )
+          continue;
+
+        const IntersectionIterator iend = gridView_.iend( element );
+        for( IntersectionIterator iit = gridView_.ibegin( element ); iit != iend; ++iit )
+        {
+          const Intersection &intersection = *iit;
+          if( intersection.boundary() && !intersection.neighbor() )
+            entries_.push_back( Entry( element.seed(), intersection.indexInInside(), intersection.boundarySegmentIndex() ) );
+        }
+      }
+    }
+
+    /** \brief obtain the grid view this index was built for */
+    const GridView &gridView () const { return gridView_; }
+
+    /** \brief number of boundary intersections */
+    Size size () const { return entries_.size(); }
+
+    /** \brief return true if the grid view has no boundary intersections */
+    bool empty () const { return entries_.empty(); }
+
+    /** \brief access the i-th boundary intersection */
+    const Entry &operator[] ( Size i ) const
+    {
+      assert( i < size() );
+      return entries_[ i ];
+    }
+
+    /** \brief begin iterator over all boundary intersections */
+    Iterator begin () const { return entries_.begin(); }
+
+    /** \brief end iterator over all boundary intersections */
+    Iterator end () const { return entries_.end(); }
+
+    /** \brief obtain the inside element of a boundary intersection */
+    ElementPointer element ( const Entry &entry ) const
+    {
+      return gridView_.grid().entityPointer( entry.seed );
+    }
+
+    /** \brief find the intersection iterator pointing to a boundary intersection
+     *
+     *  \param[in]  element  inside element of the intersection (see element())
+     *  \param[in]  entry    entry describing the boundary intersection
+     *
+     *  \returns an intersection iterator pointing to the boundary intersection
+     *           or gridView().iend( element ) if no such intersection exists
+     */
+    IntersectionIterator intersection ( const Element &element, const Entry &entry ) const
+    {
+      const IntersectionIterator iend = gridView_.iend( element );
+      for( IntersectionIterator iit = gridView_.ibegin( element ); iit != iend; ++iit )
+      {
+        if( (iit->indexInInside() == entry.indexInInside) && iit->boundary() && !iit->neighbor()
+            && (iit->boundarySegmentIndex() == entry.boundarySegmentIndex) )
+          return iit;
+      }
+      return iend;
+    }
+
+  private:
+    GridView gridView_;
+    EntryVector entries_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_UTILITY_BOUNDARYINDEX_HH
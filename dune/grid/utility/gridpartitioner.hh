@@ -0,0 +1,656 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_GRIDPARTITIONER_HH
+#define DUNE_GRID_UTILITY_GRIDPARTITIONER_HH
+
+/** \file
+ *  \brief dual graph of a GridView and pluggable partitioners for load balancing
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/gridenums.hh>
+
+namespace Dune
+{
+
+  // DualGraph
+  // ---------
+
+  /** \brief dual graph of the interior elements of a GridView
+   *
+   *  The vertices of the dual graph are the interior elements of the grid
+   *  view. Two vertices are connected by an edge if the corresponding
+   *  elements share a face, i.e., if there is an intersection with a
+   *  neighbor.
+   *
+   *  In parallel, each process holds the vertices of its interior elements,
+   *  numbered in the order of the element traversal. The vertices are also
+   *  numbered globally and consecutively per process, i.e., the local vertex
+   *  v has the global number vertexDistribution()[ rank ] + v, as expected
+   *  by distributed partitioners like ParMETIS. The neighbors of a vertex
+   *  are given by their global numbers and include vertices on other
+   *  processes. The global numbers of the latter are exchanged over the
+   *  overlap and ghost elements, so edges to other processes are only found
+   *  if the grid view provides such elements.
+   *
+   *  Each vertex carries a weight (1 by default) and the center of the
+   *  element, so that geometric partitioners can be used, too.
+   *
+   *  \note The graph is not updated automatically. Call update() after the
+   *        grid has been modified (adapt() or loadBalance()).
+   *
+   *  \tparam  GV  type of the GridView
+   */
+  template< class GV >
+  class DualGraph
+  {
+    typedef DualGraph< GV > This;
+
+    template< class T >
+    class ElementDataHandle;
+
+  public:
+    typedef GV GridView;
+
+    typedef typename GridView::ctype ctype;
+    static const int dimensionworld = GridView::dimensionworld;
+
+    typedef FieldVector< ctype, dimensionworld > GlobalCoordinate;
+
+    typedef typename GridView::template Codim< 0 >::Entity Element;
+
+    typedef std::vector< std::size_t >::const_iterator NeighborIterator;
+
+    //! number returned by vertex() for elements not in the graph
+    static const std::size_t invalid = std::size_t( -1 );
+
+    /** \brief construct the dual graph of a grid view
+     *
+     *  This constructor is collective.
+     *
+     *  \param[in]  gridView  grid view to extract the dual graph from
+     */
+    explicit DualGraph ( const GridView &gridView )
+      : gridView_( gridView )
+    {
+      update();
+    }
+
+    /** \brief rebuild the dual graph
+     *
+     *  This method has to be called after the grid was modified, e.g., by
+     *  adapt() or loadBalance(). The vertex weights are reset to 1.
+     *
+     *  This method is collective.
+     */
+    void update ()
+    {
+      typedef typename GridView::template Codim< 0 >::template Partition< Interior_Partition >::Iterator ElementIterator;
+      typedef typename GridView::IntersectionIterator IntersectionIterator;
+
+      const typename GridView::IndexSet &indexSet = gridView_.indexSet();
+      const typename GridView::CollectiveCommunication &comm = gridView_.comm();
+
+      // number the interior elements
+      vertices_.assign( indexSet.size( 0 ), invalid );
+      elementIndices_.clear();
+      centers_.clear();
+
+      const ElementIterator end = gridView_.template end< 0, Interior_Partition >();
+      for( ElementIterator it = gridView_.template begin< 0, Interior_Partition >(); it != end; ++it )
+      {
+        const std::size_t index = indexSet.index( *it );
+        vertices_[ index ] = elementIndices_.size();
+        elementIndices_.push_back( index );
+        centers_.push_back( it->geometry().center() );
+      }
+      weights_.assign( elementIndices_.size(), 1.0 );
+
+      // number the vertices globally
+      std::vector< std::size_t > sizes( comm.size() );
+      std::size_t localSize = elementIndices_.size();
+      comm.allgather( &localSize, 1, &sizes[ 0 ] );
+      vertexDistribution_.assign( 1, 0 );
+      for( int p = 0; p < comm.size(); ++p )
+        vertexDistribution_.push_back( vertexDistribution_.back() + sizes[ p ] );
+
+      // obtain the global numbers of the overlap and ghost elements
+      std::vector< std::size_t > globalVertices( indexSet.size( 0 ), invalid );
+      for( std::size_t v = 0; v < size(); ++v )
+        globalVertices[ elementIndices_[ v ] ] = globalVertex( v );
+      ElementDataHandle< std::size_t > dataHandle( indexSet, globalVertices );
+      gridView_.communicate( dataHandle, InteriorBorder_All_Interface, ForwardCommunication );
+
+      // collect the neighbors (compressed row storage)
+      offsets_.assign( 1, 0 );
+      adjacency_.clear();
+      neighborElements_.clear();
+      localEdges_ = remoteEdges_ = 0;
+      for( ElementIterator it = gridView_.template begin< 0, Interior_Partition >(); it != end; ++it )
+      {
+        const IntersectionIterator iend = gridView_.iend( *it );
+        for( IntersectionIterator iit = gridView_.ibegin( *it ); iit != iend; ++iit )
+        {
+          if( !iit->neighbor() )
+            continue;
+          const std::size_t neighborElement = indexSet.index( *iit->outside() );
+          const std::size_t neighbor = globalVertices[ neighborElement ];
+          if( neighbor == invalid )
+            continue;
+          adjacency_.push_back( neighbor );
+          neighborElements_.push_back( neighborElement );
+          if( isLocal( neighbor ) )
+            ++localEdges_;
+          else
+            ++remoteEdges_;
+        }
+        offsets_.push_back( adjacency_.size() );
+      }
+      localEdges_ /= 2;
+    }
+
+    /** \brief obtain the grid view this graph was built for */
+    const GridView &gridView () const { return gridView_; }
+
+    /** \brief number of vertices, i.e., interior elements */
+    std::size_t size () const { return elementIndices_.size(); }
+
+    /** \brief number of (undirected) edges incident to a local vertex
+     *
+     *  Edges to vertices on other processes are counted on both processes.
+     */
+    std::size_t edges () const { return localEdges_ + remoteEdges_; }
+
+    /** \brief number of edges to vertices on other processes */
+    std::size_t remoteEdges () const { return remoteEdges_; }
+
+    /** \brief first global vertex number of each process
+     *
+     *  The vector has one entry more than there are processes, the last one
+     *  being the global number of vertices.
+     */
+    const std::vector< std::size_t > &vertexDistribution () const { return vertexDistribution_; }
+
+    /** \brief global number of a local vertex */
+    std::size_t globalVertex ( std::size_t v ) const
+    {
+      assert( v < size() );
+      return vertexDistribution_[ gridView_.comm().rank() ] + v;
+    }
+
+    /** \brief return true if a global vertex number belongs to this process */
+    bool isLocal ( std::size_t globalVertex ) const
+    {
+      const int rank = gridView_.comm().rank();
+      return (globalVertex >= vertexDistribution_[ rank ]) && (globalVertex < vertexDistribution_[ rank+1 ]);
+    }
+
+    /** \brief local number of a global vertex belonging to this process */
+    std::size_t localVertex ( std::size_t globalVertex ) const
+    {
+      assert( isLocal( globalVertex ) );
+      return globalVertex - vertexDistribution_[ gridView_.comm().rank() ];
+    }
+
+    /** \brief vertex number of an element
+     *
+     *  \param[in]  elementIndex  index of the element in the grid view's index set
+     *
+     *  \returns the vertex number or invalid, if the element is not interior
+     */
+    std::size_t vertex ( std::size_t elementIndex ) const
+    {
+      assert( elementIndex < vertices_.size() );
+      return vertices_[ elementIndex ];
+    }
+
+    /** \brief index of the element belonging to a vertex */
+    std::size_t elementIndex ( std::size_t v ) const { return elementIndices_[ v ]; }
+
+    /** \brief center of the element belonging to a vertex */
+    const GlobalCoordinate &center ( std::size_t v ) const { return centers_[ v ]; }
+
+    /** \brief weight of a vertex */
+    double weight ( std::size_t v ) const { return weights_[ v ]; }
+
+    /** \brief set the vertex weights
+     *
+     *  \param[in]  elementWeights  weight of each element, indexed by the
+     *                              grid view's index set
+     */
+    void setWeights ( const std::vector< double > &elementWeights )
+    {
+      assert( elementWeights.size() == vertices_.size() );
+      for( std::size_t v = 0; v < size(); ++v )
+        weights_[ v ] = elementWeights[ elementIndices_[ v ] ];
+    }
+
+    /** \brief begin iterator over the global numbers of the neighbors of a vertex */
+    NeighborIterator beginNeighbors ( std::size_t v ) const { return adjacency_.begin() + offsets_[ v ]; }
+
+    /** \brief end iterator over the global numbers of the neighbors of a vertex */
+    NeighborIterator endNeighbors ( std::size_t v ) const { return adjacency_.begin() + offsets_[ v+1 ]; }
+
+    /** \brief position of the first neighbor of each vertex in the adjacency
+     *
+     *  The vector has size()+1 entries (xadj in METIS terminology).
+     */
+    const std::vector< std::size_t > &offsets () const { return offsets_; }
+
+    /** \brief global numbers of the neighbors of all vertices (adjncy in METIS terminology) */
+    const std::vector< std::size_t > &adjacency () const { return adjacency_; }
+
+    /** \brief obtain data of all neighbors, including those on other processes
+     *
+     *  This method is collective.
+     *
+     *  \param[in]   data          value for each local vertex
+     *  \param[out]  neighborData  value for each neighbor, in the order of
+     *                             adjacency()
+     */
+    template< class T >
+    void neighborData ( const std::vector< T > &data, std::vector< T > &neighborData ) const
+    {
+      assert( data.size() == size() );
+      std::vector< T > elementData( vertices_.size() );
+      for( std::size_t v = 0; v < size(); ++v )
+        elementData[ elementIndices_[ v ] ] = data[ v ];
+      ElementDataHandle< T > dataHandle( gridView_.indexSet(), elementData );
+      gridView_.communicate( dataHandle, InteriorBorder_All_Interface, ForwardCommunication );
+
+      neighborData.resize( adjacency_.size() );
+      for( std::size_t i = 0; i < adjacency_.size(); ++i )
+        neighborData[ i ] = elementData[ neighborElements_[ i ] ];
+    }
+
+  private:
+    GridView gridView_;
+    std::vector< std::size_t > vertices_;
+    std::vector< std::size_t > elementIndices_;
+    std::vector< GlobalCoordinate > centers_;
+    std::vector< double > weights_;
+    std::vector< std::size_t > vertexDistribution_;
+    std::vector< std::size_t > offsets_;
+    std::vector< std::size_t > adjacency_;
+    std::vector< std::size_t > neighborElements_;
+    std::size_t localEdges_, remoteEdges_;
+  };
+
+
+
+  template< class GV >
+  const std::size_t DualGraph< GV >::invalid;
+
+
+
+  // DualGraph::ElementDataHandle
+  // ----------------------------
+
+  // copies one value per element from the interior elements to their
+  // overlap and ghost copies
+  template< class GV >
+  template< class T >
+  class DualGraph< GV >::ElementDataHandle
+    : public CommDataHandleIF< ElementDataHandle< T >, T >
+  {
+    typedef typename GV::IndexSet IndexSet;
+
+  public:
+    ElementDataHandle ( const IndexSet &indexSet, std::vector< T > &data )
+      : indexSet_( indexSet ), data_( data )
+    {}
+
+    bool contains ( int dim, int codim ) const { return (codim == 0); }
+    bool fixedsize ( int dim, int codim ) const { return true; }
+
+    template< class Entity >
+    std::size_t size ( const Entity &entity ) const { return 1; }
+
+    template< class Buffer, class Entity >
+    void gather ( Buffer &buffer, const Entity &entity ) const
+    {
+      buffer.write( data_[ indexSet_.index( entity ) ] );
+    }
+
+    template< class Buffer, class Entity >
+    void scatter ( Buffer &buffer, const Entity &entity, std::size_t n )
+    {
+      assert( n == 1 );
+      buffer.read( data_[ indexSet_.index( entity ) ] );
+    }
+
+  private:
+    const IndexSet &indexSet_;
+    std::vector< T > &data_;
+  };
+
+
+
+  // GraphPartitionerInterface
+  // -------------------------
+
+  /** \brief interface for partitioners of a DualGraph
+   *
+   *  Implement this interface to plug an external graph partitioner (e.g.,
+   *  METIS or Scotch) into the GridPartitioner. Distributed partitioners
+   *  like ParMETIS can be fed directly with the vertex distribution and the
+   *  compressed row storage of the graph, i.e., vertexDistribution(),
+   *  offsets() and adjacency() (vtxdist, xadj and adjncy).
+   *
+   *  \tparam  GV  type of the GridView
+   */
+  template< class GV >
+  class GraphPartitionerInterface
+  {
+  public:
+    typedef DualGraph< GV > Graph;
+
+    virtual ~GraphPartitionerInterface () {}
+
+    /** \brief partition a dual graph
+     *
+     *  This method is collective, i.e., it is called on all processes of the
+     *  grid view's communicator with the local part of the dual graph.
+     *
+     *  \param[in]   graph     local part of the dual graph
+     *  \param[in]   numParts  number of parts
+     *  \param[out]  parts     part (in [0,numParts)) of each vertex
+     */
+    virtual void partition ( const Graph &graph, int numParts, std::vector< int > &parts ) const = 0;
+  };
+
+
+
+  // RecursiveCoordinateBisection
+  // ----------------------------
+
+  /** \brief recursive coordinate bisection of a DualGraph
+   *
+   *  The set of all vertices is cut along the longest axis of its bounding
+   *  box into two sets, whose weights correspond to the number of parts
+   *  assigned to each of them. The procedure is repeated recursively until
+   *  each set is assigned a single part. Only the element centers and the
+   *  vertex weights are used, the edges are ignored.
+   *
+   *  The bisection works in parallel: All sets on one level of the
+   *  recursion are cut simultaneously, where each cut is determined by a
+   *  bisection search using global sums.
+   */
+  template< class GV >
+  class RecursiveCoordinateBisection
+    : public GraphPartitionerInterface< GV >
+  {
+    typedef GraphPartitionerInterface< GV > Base;
+
+  public:
+    typedef typename Base::Graph Graph;
+
+    typedef typename Graph::ctype ctype;
+    static const int dimensionworld = Graph::dimensionworld;
+
+    /** \brief constructor
+     *
+     *  \param[in]  iterations  number of bisection steps used to find each cut
+     */
+    explicit RecursiveCoordinateBisection ( int iterations = 48 )
+      : iterations_( iterations )
+    {}
+
+    void partition ( const Graph &graph, int numParts, std::vector< int > &parts ) const
+    {
+      typedef std::pair< int, int > Range;
+
+      const typename Graph::GridView::CollectiveCommunication &comm = graph.gridView().comm();
+      const std::size_t size = graph.size();
+      const ctype infinity = std::numeric_limits< ctype >::max();
+
+      // all processes work on the same list of part ranges
+      std::vector< Range > ranges( 1, Range( 0, numParts ) );
+      std::vector< std::size_t > range( size, 0 );
+
+      while( true )
+      {
+        const std::size_t numRanges = ranges.size();
+        bool split = false;
+        for( std::size_t r = 0; r < numRanges; ++r )
+          split |= (ranges[ r ].second - ranges[ r ].first > 1);
+        if( !split )
+          break;
+
+        // compute bounding boxes and weights of all ranges
+        std::vector< ctype > lower( numRanges*dimensionworld, infinity );
+        std::vector< ctype > upper( numRanges*dimensionworld, -infinity );
+        std::vector< double > weight( numRanges, 0.0 );
+        for( std::size_t v = 0; v < size; ++v )
+        {
+          const std::size_t r = range[ v ];
+          for( int k = 0; k < dimensionworld; ++k )
+          {
+            lower[ r*dimensionworld + k ] = std::min( lower[ r*dimensionworld + k ], graph.center( v )[ k ] );
+            upper[ r*dimensionworld + k ] = std::max( upper[ r*dimensionworld + k ], graph.center( v )[ k ] );
+          }
+          weight[ r ] += graph.weight( v );
+        }
+        comm.min( &lower[ 0 ], lower.size() );
+        comm.max( &upper[ 0 ], upper.size() );
+        comm.sum( &weight[ 0 ], weight.size() );
+
+        // choose the longest axis and the weight on the lower side of each cut
+        std::vector< int > axis( numRanges, 0 );
+        std::vector< double > lowerWeight( numRanges, 0.0 );
+        std::vector< ctype > cutLower( numRanges ), cutUpper( numRanges );
+        for( std::size_t r = 0; r < numRanges; ++r )
+        {
+          for( int k = 1; k < dimensionworld; ++k )
+          {
+            const ctype extent = upper[ r*dimensionworld + k ] - lower[ r*dimensionworld + k ];
+            if( extent > upper[ r*dimensionworld + axis[ r ] ] - lower[ r*dimensionworld + axis[ r ] ] )
+              axis[ r ] = k;
+          }
+          const Range &rg = ranges[ r ];
+          const int middle = rg.first + (rg.second - rg.first) / 2;
+          lowerWeight[ r ] = weight[ r ] * double( middle - rg.first ) / double( rg.second - rg.first );
+          cutLower[ r ] = lower[ r*dimensionworld + axis[ r ] ];
+          cutUpper[ r ] = upper[ r*dimensionworld + axis[ r ] ];
+        }
+
+        // find the cuts by bisection
+        std::vector< double > below( numRanges );
+        for( int i = 0; i < iterations_; ++i )
+        {
+          std::fill( below.begin(), below.end(), 0.0 );
+          for( std::size_t v = 0; v < size; ++v )
+          {
+            const std::size_t r = range[ v ];
+            if( graph.center( v )[ axis[ r ] ] < cut( cutLower[ r ], cutUpper[ r ] ) )
+              below[ r ] += graph.weight( v );
+          }
+          comm.sum( &below[ 0 ], below.size() );
+
+          for( std::size_t r = 0; r < numRanges; ++r )
+          {
+            if( below[ r ] < lowerWeight[ r ] )
+              cutLower[ r ] = cut( cutLower[ r ], cutUpper[ r ] );
+            else
+              cutUpper[ r ] = cut( cutLower[ r ], cutUpper[ r ] );
+          }
+        }
+
+        // split the ranges and assign the vertices to the halves
+        std::vector< Range > newRanges;
+        std::vector< std::size_t > lowerRange( numRanges ), upperRange( numRanges );
+        for( std::size_t r = 0; r < numRanges; ++r )
+        {
+          const Range &rg = ranges[ r ];
+          const int middle = rg.first + (rg.second - rg.first) / 2;
+          lowerRange[ r ] = upperRange[ r ] = newRanges.size();
+          if( middle > rg.first )
+          {
+            newRanges.push_back( Range( rg.first, middle ) );
+            upperRange[ r ] = newRanges.size();
+          }
+          newRanges.push_back( Range( middle, rg.second ) );
+        }
+        for( std::size_t v = 0; v < size; ++v )
+        {
+          const std::size_t r = range[ v ];
+          const bool isLower = (graph.center( v )[ axis[ r ] ] < cut( cutLower[ r ], cutUpper[ r ] ));
+          range[ v ] = (isLower ? lowerRange[ r ] : upperRange[ r ]);
+        }
+        ranges.swap( newRanges );
+      }
+
+      parts.resize( size );
+      for( std::size_t v = 0; v < size; ++v )
+        parts[ v ] = ranges[ range[ v ] ].first;
+    }
+
+  private:
+    static ctype cut ( const ctype &lower, const ctype &upper ) { return ctype( 0.5 )*(lower + upper); }
+
+    int iterations_;
+  };
+
+
+
+  // GridPartitioner
+  // ---------------
+
+  /** \brief compute a partition of a GridView for load balancing
+   *
+   *  The GridPartitioner builds the dual graph of the interior elements of
+   *  a grid view and hands it to a partitioner implementing the
+   *  GraphPartitionerInterface. If no partitioner is given, the recursive
+   *  coordinate bisection is used.
+   *
+   *  The result is a target process for each element, which can be passed
+   *  to grids supporting a prescribed partition, e.g.,
+   *  \code
+   *  GridPartitioner< Grid::LeafGridView > partitioner( grid.leafGridView() );
+   *  std::vector< int > targets;
+   *  partitioner.partition( targets );
+   *  grid.loadBalance( targets, 0 );   // UGGrid
+   *  \endcode
+   *
+   *  \tparam  GV  type of the GridView
+   */
+  template< class GV >
+  class GridPartitioner
+  {
+    typedef GridPartitioner< GV > This;
+
+  public:
+    typedef GV GridView;
+
+    typedef DualGraph< GridView > Graph;
+    typedef GraphPartitionerInterface< GridView > Partitioner;
+
+    /** \brief constructor
+     *
+     *  \param[in]  gridView     grid view to partition
+     *  \param[in]  partitioner  graph partitioner to use (the recursive
+     *                           coordinate bisection is used if 0 is passed)
+     *
+     *  \note The partitioner is not copied and must remain valid during the
+     *        lifetime of this object.
+     */
+    explicit GridPartitioner ( const GridView &gridView, const Partitioner *partitioner = 0 )
+      : graph_( gridView ),
+        partitioner_( partitioner ? partitioner : &rcb_ )
+    {}
+
+    /** \brief obtain the dual graph */
+    const Graph &graph () const { return graph_; }
+
+    /** \brief rebuild the dual graph after the grid was modified */
+    void update () { graph_.update(); }
+
+    /** \brief compute a new process for each element
+     *
+     *  This method is collective.
+     *
+     *  \param[out]  targets  new process of each element, indexed by the grid
+     *                        view's index set (elements not in the interior
+     *                        partition keep the current process)
+     */
+    void partition ( std::vector< int > &targets ) const
+    {
+      const int rank = graph_.gridView().comm().rank();
+      const int size = graph_.gridView().comm().size();
+
+      std::vector< int > parts;
+      partitioner_->partition( graph_, size, parts );
+      assert( parts.size() == graph_.size() );
+
+      targets.assign( graph_.gridView().indexSet().size( 0 ), rank );
+      for( std::size_t v = 0; v < graph_.size(); ++v )
+        targets[ graph_.elementIndex( v ) ] = parts[ v ];
+    }
+
+    /** \brief compute a new process for each element respecting element weights
+     *
+     *  This method is collective.
+     *
+     *  \param[in]   elementWeights  weight of each element, indexed by the grid
+     *                               view's index set
+     *  \param[out]  targets         new process of each element (see above)
+     */
+    void partition ( const std::vector< double > &elementWeights, std::vector< int > &targets )
+    {
+      graph_.setWeights( elementWeights );
+      partition( targets );
+    }
+
+    /** \brief number of edges of the dual graph cut by a partition
+     *
+     *  The result is summed over all processes and includes the edges
+     *  between elements on different processes, each counted once.
+     *
+     *  This method is collective.
+     *
+     *  \param[in]  targets  process of each element, as returned by partition()
+     */
+    std::size_t edgeCut ( const std::vector< int > &targets ) const
+    {
+      std::vector< int > parts( graph_.size() );
+      for( std::size_t v = 0; v < graph_.size(); ++v )
+        parts[ v ] = targets[ graph_.elementIndex( v ) ];
+
+      // the parts of neighbors on other processes are communicated
+      std::vector< int > neighborParts;
+      graph_.neighborData( parts, neighborParts );
+
+      const std::vector< std::size_t > &offsets = graph_.offsets();
+      const std::vector< std::size_t > &adjacency = graph_.adjacency();
+      std::size_t cut = 0;
+      for( std::size_t v = 0; v < graph_.size(); ++v )
+      {
+        // count each edge at the vertex with the smaller global number
+        const std::size_t globalVertex = graph_.globalVertex( v );
+        for( std::size_t i = offsets[ v ]; i < offsets[ v+1 ]; ++i )
+          cut += ((adjacency[ i ] > globalVertex) && (neighborParts[ i ] != parts[ v ]) ? 1 : 0);
+      }
+      return graph_.gridView().comm().sum( cut );
+    }
+
+  private:
+    GridPartitioner ( const This & );
+    This &operator= ( const This & );
+
+    Graph graph_;
+    RecursiveCoordinateBisection< GridView > rcb_;
+    const Partitioner *partitioner_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_UTILITY_GRIDPARTITIONER_HH
@@ -0,0 +1,107 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test for the BoundaryIntersectionIndex
+ */
+
+#include <config.h>
+
+#include <iostream>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/grid/utility/boundaryindex.hh>
+
+using namespace Dune;
+
+template< class GridView >
+bool test ( const GridView &view )
+{
+  typedef typename GridView::template Codim< 0 >::Iterator ElementIterator;
+  typedef typename GridView::IntersectionIterator IntersectionIterator;
+
+  // count the boundary intersections by a full sweep
+  std::size_t count = 0;
+  const ElementIterator end = view.template end< 0 >();
+  for( ElementIterator it = view.template begin< 0 >(); it != end; ++it )
+  {
+    const IntersectionIterator iend = view.iend( *it );
+    for( IntersectionIterator iit = view.ibegin( *it ); iit != iend; ++iit )
+    {
+      if( iit->boundary() && !iit->neighbor() )
+        ++count;
+    }
+  }
+
+  BoundaryIntersectionIndex< GridView > boundaryIndex( view );
+  if( boundaryIndex.size() != count )
+  {
+    std::cout << "ERROR: boundary index contains " << boundaryIndex.size()
+              << " intersections, expected " << count << std::endl;
+    return false;
+  }
+
+  typedef typename BoundaryIntersectionIndex< GridView >::Iterator Iterator;
+  for( Iterator it = boundaryIndex.begin(); it != boundaryIndex.end(); ++it )
+  {
+    typename BoundaryIntersectionIndex< GridView >::ElementPointer element = boundaryIndex.element( *it );
+    const IntersectionIterator iit = boundaryIndex.intersection( *element, *it );
+    if( iit == view.iend( *element ) )
+    {
+      std::cout << "ERROR: could not recover boundary intersection" << std::endl;
+      return false;
+    }
+    if( (iit->indexInInside() != it->indexInInside) || (iit->boundarySegmentIndex() != it->boundarySegmentIndex) )
+    {
+      std::cout << "ERROR: wrong boundary intersection recovered" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int main ( int argc, char **argv )
+try {
+
+  // this method calls MPI_Init, if MPI is enabled
+  MPIHelper::instance( argc, argv );
+
+  bool ret = true;
+
+  {
+    typedef YaspGrid< 2 > GridType;
+    Dune::FieldVector< double, 2 > Len; Len = 1.0;
+    Dune::array< int, 2 > s = { {4, 3} };
+    std::bitset< 2 > p;
+    int overlap = 1;
+    GridType grid( Len, s, p, overlap );
+    std::cout << "Testing YaspGrid<2>" << std::endl;
+    ret &= test( grid.leafGridView() );
+    grid.globalRefine( 1 );
+    ret &= test( grid.leafGridView() );
+    ret &= test( grid.levelGridView( 0 ) );
+  }
+
+  {
+    typedef YaspGrid< 3 > GridType;
+    Dune::FieldVector< double, 3 > Len; Len = 1.0;
+    Dune::array< int, 3 > s = { {3, 2, 2} };
+    std::bitset< 3 > p;
+    p[ 0 ] = true;
+    int overlap = 1;
+    GridType grid( Len, s, p, overlap );
+    std::cout << "Testing periodic YaspGrid<3>" << std::endl;
+    ret &= test( grid.leafGridView() );
+  }
+
+  return (ret ? 0 : 1);
+
+}
+catch (Exception &e) {
+  std::cerr << e << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
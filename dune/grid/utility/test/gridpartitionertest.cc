@@ -0,0 +1,225 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test and benchmark for the GridPartitioner
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/grid/utility/gridpartitioner.hh>
+
+using namespace Dune;
+
+// number of edges cut by a partition, including edges between processes
+template< class GridView >
+std::size_t edgeCut ( const DualGraph< GridView > &graph, const std::vector< int > &parts )
+{
+  std::vector< int > neighborParts;
+  graph.neighborData( parts, neighborParts );
+
+  std::size_t cut = 0, i = 0;
+  for( std::size_t v = 0; v < graph.size(); ++v )
+  {
+    typedef typename DualGraph< GridView >::NeighborIterator NeighborIterator;
+    for( NeighborIterator it = graph.beginNeighbors( v ); it != graph.endNeighbors( v ); ++it, ++i )
+      cut += ((*it > graph.globalVertex( v )) && (neighborParts[ i ] != parts[ v ]) ? 1 : 0);
+  }
+  return graph.gridView().comm().sum( cut );
+}
+
+// check a partition into numParts parts and print its edge cut and imbalance
+template< class GridView >
+bool checkPartition ( const DualGraph< GridView > &graph, int numParts, const std::vector< int > &parts,
+                      std::size_t expectedCut )
+{
+  const typename GridView::CollectiveCommunication &comm = graph.gridView().comm();
+
+  std::vector< double > weights( numParts, 0.0 );
+  for( std::size_t v = 0; v < graph.size(); ++v )
+  {
+    if( (parts[ v ] < 0) || (parts[ v ] >= numParts) )
+    {
+      std::cout << "ERROR: invalid part " << parts[ v ] << std::endl;
+      return false;
+    }
+    weights[ parts[ v ] ] += graph.weight( v );
+  }
+  comm.sum( &weights[ 0 ], numParts );
+  const std::size_t cut = edgeCut( graph, parts );
+
+  double total = 0.0, maxWeight = 0.0;
+  for( int p = 0; p < numParts; ++p )
+  {
+    total += weights[ p ];
+    maxWeight = std::max( maxWeight, weights[ p ] );
+  }
+  const double imbalance = maxWeight * numParts / total;
+
+  if( comm.rank() == 0 )
+    std::cout << "  " << numParts << " parts: edge cut = " << cut << ", imbalance = " << imbalance << std::endl;
+
+  if( (expectedCut > 0) && (cut != expectedCut) )
+  {
+    std::cout << "ERROR: edge cut is " << cut << ", expected " << expectedCut << std::endl;
+    return false;
+  }
+  if( imbalance > 1.25 )
+  {
+    std::cout << "ERROR: partition is not balanced" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template< class GridView >
+bool test ( const GridView &view, int n )
+{
+  bool ret = true;
+  const int dim = GridView::dimension;
+
+  Timer timer;
+  DualGraph< GridView > graph( view );
+  const double graphTime = timer.elapsed();
+
+  // a structured grid with n^dim elements has dim * n^(dim-1) * (n-1) inner
+  // faces; edges between processes are counted on both processes
+  std::size_t expectedEdges = dim * (n-1);
+  for( int i = 1; i < dim; ++i )
+    expectedEdges *= n;
+  const std::size_t remoteEdges = view.comm().sum( graph.remoteEdges() );
+  const std::size_t edges = view.comm().sum( graph.edges() ) - remoteEdges / 2;
+  if( (remoteEdges % 2 != 0) || (edges != expectedEdges) )
+  {
+    std::cout << "ERROR: dual graph has " << edges << " edges, expected " << expectedEdges << std::endl;
+    ret = false;
+  }
+
+  // the global vertex numbers are consecutive
+  const std::vector< std::size_t > &distribution = graph.vertexDistribution();
+  if( (distribution.size() != std::size_t( view.comm().size()+1 ))
+      || (distribution.back() != std::size_t( view.comm().sum( int( graph.size() ) ) ))
+      || (graph.size() > 0 && graph.localVertex( graph.globalVertex( graph.size()-1 ) ) != graph.size()-1) )
+  {
+    std::cout << "ERROR: wrong global vertex numbering" << std::endl;
+    ret = false;
+  }
+
+  // the current distribution cuts exactly the edges between processes
+  std::vector< int > ranks( graph.size(), view.comm().rank() );
+  if( edgeCut( graph, ranks ) != remoteEdges / 2 )
+  {
+    std::cout << "ERROR: edge cut of the current distribution is " << edgeCut( graph, ranks )
+              << ", expected " << remoteEdges / 2 << std::endl;
+    ret = false;
+  }
+  if( view.comm().rank() == 0 )
+    std::cout << "  dual graph built in " << graphTime << "s" << std::endl;
+
+  RecursiveCoordinateBisection< GridView > rcb;
+  for( int numParts = 1; numParts <= 8; ++numParts )
+  {
+    std::vector< int > parts;
+    timer.reset();
+    rcb.partition( graph, numParts, parts );
+    const double partitionTime = timer.elapsed();
+    if( view.comm().rank() == 0 )
+      std::cout << "  partitioned in " << partitionTime << "s" << std::endl;
+
+    // cutting a square into quadrants cuts 2n faces
+    ret &= checkPartition( graph, numParts, parts, (numParts == 4) && (dim == 2) ? 2*n : 0 );
+  }
+
+  // weighted partition: the elements get heavier in x-direction
+  std::vector< double > weights( view.indexSet().size( 0 ) );
+  typedef typename GridView::template Codim< 0 >::Iterator ElementIterator;
+  const ElementIterator end = view.template end< 0 >();
+  for( ElementIterator it = view.template begin< 0 >(); it != end; ++it )
+    weights[ view.indexSet().index( *it ) ] = 1.0 + it->geometry().center()[ 0 ];
+  graph.setWeights( weights );
+
+  std::vector< int > parts;
+  rcb.partition( graph, 4, parts );
+  ret &= checkPartition( graph, 4, parts, 0 );
+
+  // the grid partitioner assigns one part to each process
+  GridPartitioner< GridView > partitioner( view );
+  std::vector< int > targets;
+  partitioner.partition( weights, targets );
+  if( targets.size() != std::size_t( view.indexSet().size( 0 ) ) )
+  {
+    std::cout << "ERROR: wrong number of targets" << std::endl;
+    ret = false;
+  }
+  rcb.partition( graph, view.comm().size(), parts );
+  if( partitioner.edgeCut( targets ) != edgeCut( graph, parts ) )
+  {
+    std::cout << "ERROR: GridPartitioner reports an edge cut of " << partitioner.edgeCut( targets )
+              << ", expected " << edgeCut( graph, parts ) << std::endl;
+    ret = false;
+  }
+  if( (view.comm().size() == 1) && (partitioner.edgeCut( targets ) != 0) )
+  {
+    std::cout << "ERROR: nonzero edge cut for a single process" << std::endl;
+    ret = false;
+  }
+
+  // the current distribution of the grid cuts the edges between processes
+  std::vector< int > current( view.indexSet().size( 0 ), view.comm().rank() );
+  if( partitioner.edgeCut( current ) != remoteEdges / 2 )
+  {
+    std::cout << "ERROR: GridPartitioner misses edges between processes" << std::endl;
+    ret = false;
+  }
+
+  return ret;
+}
+
+int main ( int argc, char **argv )
+try {
+
+  // this method calls MPI_Init, if MPI is enabled
+  MPIHelper::instance( argc, argv );
+
+  bool ret = true;
+
+  {
+    typedef YaspGrid< 2 > GridType;
+    const int n = 64;
+    Dune::FieldVector< double, 2 > Len; Len = 1.0;
+    Dune::array< int, 2 > s = { {n, n} };
+    std::bitset< 2 > p;
+    // the overlap provides the neighbors on other processes
+    GridType grid( Len, s, p, 1 );
+    std::cout << "Testing YaspGrid<2>" << std::endl;
+    ret &= test( grid.leafGridView(), n );
+  }
+
+  {
+    typedef YaspGrid< 3 > GridType;
+    const int n = 16;
+    Dune::FieldVector< double, 3 > Len; Len = 1.0;
+    Dune::array< int, 3 > s = { {n, n, n} };
+    std::bitset< 3 > p;
+    GridType grid( Len, s, p, 1 );
+    std::cout << "Testing YaspGrid<3>" << std::endl;
+    ret &= test( grid.leafGridView(), n );
+  }
+
+  return (ret ? 0 : 1);
+
+}
+catch (Exception &e) {
+  std::cerr << e << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
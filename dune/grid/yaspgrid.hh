@@ -7,6 +7,8 @@
 #include <vector>
 #include <algorithm>
 #include <stack>
+#include <bitset>
+#include <cstddef>
 
 // either include stdint.h or provide fallback for uint8_t
 #if HAVE_STDINT_H
@@ -28,6 +30,7 @@ typedef unsigned char uint8_t;
 #include <dune/geometry/axisalignedcubegeometry.hh>
 #include <dune/grid/common/indexidset.hh>
 #include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/adaptationstatistics.hh>
 
 
 #if HAVE_MPI
@@ -70,6 +73,8 @@ namespace Dune {
   template<class GridImp>            class YaspHierarchicIterator;
   template<class GridImp, bool isLeafIndexSet>                     class YaspIndexSet;
   template<class GridImp>            class YaspGlobalIdSet;
+  template<class GridImp>            class YaspStencil;
+  template<class GridImp>            class YaspThreadPartition;
 
   namespace FacadeOptions
   {
@@ -100,6 +105,8 @@ namespace Dune {
 #include <dune/grid/yaspgrid/yaspgridleveliterator.hh>
 #include <dune/grid/yaspgrid/yaspgridindexsets.hh>
 #include <dune/grid/yaspgrid/yaspgrididset.hh>
+#include <dune/grid/yaspgrid/yaspgridstencil.hh>
+#include <dune/grid/yaspgrid/yaspgridthreadpartition.hh>
 
 namespace Dune {
 
@@ -221,11 +228,12 @@ namespace Dune {
       SubYGrid<dim,ctype> cell_overlap;     // we have no ghost cells, so our part is overlap completely
       SubYGrid<dim,ctype> cell_interior;    // interior cells are a subgrid of all cells
 
-      std::deque<Intersection> send_cell_overlap_overlap;  // each intersection is a subgrid of overlap
-      std::deque<Intersection> recv_cell_overlap_overlap;  // each intersection is a subgrid of overlap
+      // the lists of intersections are computed on first use (see YaspGrid::communicationInterface)
+      mutable std::vector<Intersection> send_cell_overlap_overlap;  // each intersection is a subgrid of overlap
+      mutable std::vector<Intersection> recv_cell_overlap_overlap;  // each intersection is a subgrid of overlap
 
-      std::deque<Intersection> send_cell_interior_overlap; // each intersection is a subgrid of overlap
-      std::deque<Intersection> recv_cell_overlap_interior; // each intersection is a subgrid of overlap
+      mutable std::vector<Intersection> send_cell_interior_overlap; // each intersection is a subgrid of overlap
+      mutable std::vector<Intersection> recv_cell_overlap_interior; // each intersection is a subgrid of overlap
 
       // vertex (codim dim) data
       YGrid<dim,ctype> vertex_global;           // the whole vertex grid on that level
@@ -234,17 +242,20 @@ namespace Dune {
       SubYGrid<dim,ctype> vertex_interiorborder; // subgrid containing only interior and border
       SubYGrid<dim,ctype> vertex_interior;      // subgrid containing only interior
 
-      std::deque<Intersection> send_vertex_overlapfront_overlapfront; // each intersection is a subgrid of overlapfront
-      std::deque<Intersection> recv_vertex_overlapfront_overlapfront; // each intersection is a subgrid of overlapfront
+      mutable std::vector<Intersection> send_vertex_overlapfront_overlapfront; // each intersection is a subgrid of overlapfront
+      mutable std::vector<Intersection> recv_vertex_overlapfront_overlapfront; // each intersection is a subgrid of overlapfront
 
-      std::deque<Intersection> send_vertex_overlap_overlapfront; // each intersection is a subgrid of overlapfront
-      std::deque<Intersection> recv_vertex_overlapfront_overlap; // each intersection is a subgrid of overlapfront
+      mutable std::vector<Intersection> send_vertex_overlap_overlapfront; // each intersection is a subgrid of overlapfront
+      mutable std::vector<Intersection> recv_vertex_overlapfront_overlap; // each intersection is a subgrid of overlapfront
 
-      std::deque<Intersection> send_vertex_interiorborder_interiorborder; // each intersection is a subgrid of overlapfront
-      std::deque<Intersection> recv_vertex_interiorborder_interiorborder; // each intersection is a subgrid of overlapfront
+      mutable std::vector<Intersection> send_vertex_interiorborder_interiorborder; // each intersection is a subgrid of overlapfront
+      mutable std::vector<Intersection> recv_vertex_interiorborder_interiorborder; // each intersection is a subgrid of overlapfront
 
-      std::deque<Intersection> send_vertex_interiorborder_overlapfront; // each intersection is a subgrid of overlapfront
-      std::deque<Intersection> recv_vertex_overlapfront_interiorborder; // each intersection is a subgrid of overlapfront
+      mutable std::vector<Intersection> send_vertex_interiorborder_overlapfront; // each intersection is a subgrid of overlapfront
+      mutable std::vector<Intersection> recv_vertex_overlapfront_interiorborder; // each intersection is a subgrid of overlapfront
+
+      // interfaces whose lists of intersections have been computed
+      mutable std::bitset<6> interfaces;
 
       // general
       YaspGrid<dim>* mg;  // each grid level knows its multigrid
@@ -266,6 +277,15 @@ namespace Dune {
       return _torus;
     }
 
+    /** \brief exchange messages with processes on the same node through shared memory
+
+       Collective; see Torus::sharedMemoryExchange() for details.
+     */
+    void sharedMemoryExchange (bool enable)
+    {
+      _torus.sharedMemoryExchange(enable);
+    }
+
     //! Iterator over the grid levels
     typedef typename ReservedVector<YGridLevel,32>::const_iterator YGridLevelIterator;
 
@@ -349,10 +369,6 @@ namespace Dune {
       for (int i=0; i<dim; i++) offset[i] = o_interior[i]-o_overlap[i];
       g.cell_interior = SubYGrid<dim,ctype>(o_interior,s_interior,offset,s_overlap,h,r);
 
-      // compute cell intersections
-      intersections(g.cell_overlap,g.cell_overlap,g.cell_global.size(),g.send_cell_overlap_overlap,g.recv_cell_overlap_overlap);
-      intersections(g.cell_interior,g.cell_overlap,g.cell_global.size(),g.send_cell_interior_overlap,g.recv_cell_overlap_interior);
-
       // now we can do the vertex grids. They are derived completely from the cell grids
       iTupel o_vertex_global, s_vertex_global;
       for (int i=0; i<dim; i++) r[i] = 0.0;  // the shift for vertices is zero, and the mesh size is same as for cells
@@ -428,15 +444,8 @@ namespace Dune {
       }
       g.vertex_interior = SubYGrid<dim,ctype>(o_vertex_interior,s_vertex_interior,offset,s_vertex_overlapfront,h,r);
 
-      // compute vertex intersections
-      intersections(g.vertex_overlapfront,g.vertex_overlapfront,g.cell_global.size(),
-                    g.send_vertex_overlapfront_overlapfront,g.recv_vertex_overlapfront_overlapfront);
-      intersections(g.vertex_overlap,g.vertex_overlapfront,g.cell_global.size(),
-                    g.send_vertex_overlap_overlapfront,g.recv_vertex_overlapfront_overlap);
-      intersections(g.vertex_interiorborder,g.vertex_interiorborder,g.cell_global.size(),
-                    g.send_vertex_interiorborder_interiorborder,g.recv_vertex_interiorborder_interiorborder);
-      intersections(g.vertex_interiorborder,g.vertex_overlapfront,g.cell_global.size(),
-                    g.send_vertex_interiorborder_overlapfront,g.recv_vertex_overlapfront_interiorborder);
+      // the intersections with neighboring processes are computed on first use
+      g.interfaces.reset();
 
       // return the whole thing
       return g;
@@ -465,7 +474,7 @@ namespace Dune {
      * \note sendgrid/recvgrid may be SubYGrids. Since intersection method is virtual it should work properly
      */
     void intersections (const SubYGrid<dim,ctype>& sendgrid, const SubYGrid<dim,ctype>& recvgrid, const iTupel& size,
-                        std::deque<Intersection>& sendlist, std::deque<Intersection>& recvlist)
+                        std::vector<Intersection>& sendlist, std::vector<Intersection>& recvlist) const
     {
       // the exchange buffers
       std::vector<YGrid<dim,ctype> > send_recvgrid(_torus.neighbors());
@@ -561,7 +570,7 @@ namespace Dune {
         send_intersection.grid = sendgrid.intersection(recv_recvgrid[i.index()]);
         send_intersection.rank = i.rank();
         send_intersection.distance = i.distance();
-        if (!send_intersection.grid.empty()) sendlist.push_front(send_intersection);
+        if (!send_intersection.grid.empty()) sendlist.push_back(send_intersection);
 
         Intersection recv_intersection;
         yg = mpifriendly_recv_sendgrid[i.index()];
@@ -571,6 +580,70 @@ namespace Dune {
         recv_intersection.distance = i.distance();
         if(!recv_intersection.grid.empty()) recvlist.push_back(recv_intersection);
       }
+
+      // the send list is kept in reverse order of the neighbors
+      std::reverse(sendlist.begin(),sendlist.end());
+
+      // release excess capacity
+      std::vector<Intersection>(sendlist).swap(sendlist);
+      std::vector<Intersection>(recvlist).swap(recvlist);
+    }
+
+    //! communication interfaces of a grid level (pairs of lists of intersections)
+    enum InterfaceId {
+      cellOverlapOverlap, cellInteriorOverlap,
+      vertexOverlapFrontOverlapFront, vertexOverlapOverlapFront,
+      vertexInteriorBorderInteriorBorder, vertexInteriorBorderOverlapFront
+    };
+
+    /** \brief Return the lists of intersections of a communication interface
+     *
+     * The lists are computed on first use. This requires communication with
+     * the neighboring processes, so all processes must request the same
+     * interfaces in the same order (as is the case in communicate).
+     */
+    void communicationInterface (const YGridLevel& g, InterfaceId id,
+                    const std::vector<Intersection>*& sendlist, const std::vector<Intersection>*& recvlist) const
+    {
+      const SubYGrid<dim,ctype>* sendgrid = 0;
+      const SubYGrid<dim,ctype>* recvgrid = 0;
+      std::vector<Intersection>* send = 0;
+      std::vector<Intersection>* recv = 0;
+      switch (id)
+      {
+      case cellOverlapOverlap :
+        sendgrid = &g.cell_overlap; recvgrid = &g.cell_overlap;
+        send = &g.send_cell_overlap_overlap; recv = &g.recv_cell_overlap_overlap;
+        break;
+      case cellInteriorOverlap :
+        sendgrid = &g.cell_interior; recvgrid = &g.cell_overlap;
+        send = &g.send_cell_interior_overlap; recv = &g.recv_cell_overlap_interior;
+        break;
+      case vertexOverlapFrontOverlapFront :
+        sendgrid = &g.vertex_overlapfront; recvgrid = &g.vertex_overlapfront;
+        send = &g.send_vertex_overlapfront_overlapfront; recv = &g.recv_vertex_overlapfront_overlapfront;
+        break;
+      case vertexOverlapOverlapFront :
+        sendgrid = &g.vertex_overlap; recvgrid = &g.vertex_overlapfront;
+        send = &g.send_vertex_overlap_overlapfront; recv = &g.recv_vertex_overlapfront_overlap;
+        break;
+      case vertexInteriorBorderInteriorBorder :
+        sendgrid = &g.vertex_interiorborder; recvgrid = &g.vertex_interiorborder;
+        send = &g.send_vertex_interiorborder_interiorborder; recv = &g.recv_vertex_interiorborder_interiorborder;
+        break;
+      case vertexInteriorBorderOverlapFront :
+        sendgrid = &g.vertex_interiorborder; recvgrid = &g.vertex_overlapfront;
+        send = &g.send_vertex_interiorborder_overlapfront; recv = &g.recv_vertex_overlapfront_interiorborder;
+        break;
+      }
+
+      if (!g.interfaces[id])
+      {
+        intersections(*sendgrid,*recvgrid,g.cell_global.size(),*send,*recv);
+        g.interfaces[id] = true;
+      }
+      sendlist = send;
+      recvlist = recv;
     }
 
   protected:
@@ -628,7 +701,7 @@ namespace Dune {
 
     //! shorthand for some data types
     typedef typename SubYGrid<dim,ctype>::TransformingSubIterator TSI;
-    typedef typename std::deque<Intersection>::const_iterator ISIT;
+    typedef typename std::vector<Intersection>::const_iterator ISIT;
 
     //! The constructor of the old MultiYGrid class
     void MultiYGridSetup (
@@ -883,6 +956,9 @@ namespace Dune {
         DUNE_THROW(GridError, "Only " << maxLevel() << " levels left. " <<
                    "Coarsening " << -refCount << " levels requested!");
 
+      AdaptationStatistics::Timer timer(adaptationStatistics_.globalRefineTime);
+      const int oldSize = size(0);
+
       // If refCount is negative then coarsen the grid
       for (int k=refCount; k<0; k++)
       {
@@ -892,8 +968,10 @@ namespace Dune {
         // reduce maxlevel
         _levels.pop_back();
 
+        AdaptationStatistics::Timer indexSetTimer(adaptationStatistics_.indexSetTime);
         setsizes();
         indexsets.pop_back();
+        AdaptationStatistics::count(adaptationStatistics_.coarsened, size(0));
       }
 
       // If refCount is positive refine the grid
@@ -918,12 +996,17 @@ namespace Dune {
         for (int i=0; i<dim; i++)
           s_interior[i] = 2*cg.cell_interior.size(i);
 
+        AdaptationStatistics::count(adaptationStatistics_.refined, size(0));
+
         // add level
         _levels.push_back( makelevel(_levels.size(),_LL,s,_periodic,o_interior,s_interior,overlap) );
 
+        AdaptationStatistics::Timer indexSetTimer(adaptationStatistics_.indexSetTime);
         setsizes();
         indexsets.push_back( make_shared<YaspIndexSet<const YaspGrid<dim>, false > >(*this,maxLevel()) );
       }
+
+      adaptationStatistics_.changeElements(oldSize, size(0));
     }
 
     /**
@@ -951,6 +1034,10 @@ namespace Dune {
       assert(adaptActive == false);
       if (e.level() != maxLevel()) return false;
       adaptRefCount = std::max(adaptRefCount, refCount);
+      if (refCount > 0)
+        AdaptationStatistics::count(adaptationStatistics_.markedForRefinement);
+      else if (refCount < 0)
+        AdaptationStatistics::count(adaptationStatistics_.markedForCoarsening);
       return true;
     }
 
@@ -968,6 +1055,8 @@ namespace Dune {
     //! map adapt to global refine
     bool adapt ()
     {
+      AdaptationStatistics::Timer timer(adaptationStatistics_.adaptTime);
+      AdaptationStatistics::count(adaptationStatistics_.adaptCalls);
       globalRefine(adaptRefCount);
       return (adaptRefCount > 0);
     }
@@ -975,6 +1064,7 @@ namespace Dune {
     //! returns true, if the grid will be coarsened
     bool preAdapt ()
     {
+      AdaptationStatistics::Timer timer(adaptationStatistics_.preAdaptTime);
       adaptActive = true;
       adaptRefCount = comm().max(adaptRefCount);
       return (adaptRefCount < 0);
@@ -983,10 +1073,23 @@ namespace Dune {
     //! clean up some markers
     void postAdapt()
     {
+      AdaptationStatistics::Timer timer(adaptationStatistics_.postAdaptTime);
       adaptActive = false;
       adaptRefCount = 0;
     }
 
+    //! obtain counters and timers of the adaptation process
+    const AdaptationStatistics &adaptationStatistics () const
+    {
+      return adaptationStatistics_;
+    }
+
+    //! obtain counters and timers of the adaptation process (e.g., to reset them)
+    AdaptationStatistics &adaptationStatistics ()
+    {
+      return adaptationStatistics_;
+    }
+
     //! one past the end on this level
     template<int cd, PartitionIteratorType pitype>
     typename Traits::template Codim<cd>::template Partition<pitype>::LevelIterator lbegin (int level) const
@@ -1156,46 +1259,27 @@ namespace Dune {
       YGridLevelIterator g = begin(level);
 
       // find send/recv lists or throw error
-      const std::deque<Intersection>* sendlist=0;
-      const std::deque<Intersection>* recvlist=0;
+      const std::vector<Intersection>* sendlist=0;
+      const std::vector<Intersection>* recvlist=0;
       if (codim==0) // the elements
       {
         if (iftype==InteriorBorder_InteriorBorder_Interface)
           return; // there is nothing to do in this case
         if (iftype==InteriorBorder_All_Interface)
-        {
-          sendlist = &g->send_cell_interior_overlap;
-          recvlist = &g->recv_cell_overlap_interior;
-        }
+          communicationInterface(*g,cellInteriorOverlap,sendlist,recvlist);
         if (iftype==Overlap_OverlapFront_Interface || iftype==Overlap_All_Interface || iftype==All_All_Interface)
-        {
-          sendlist = &g->send_cell_overlap_overlap;
-          recvlist = &g->recv_cell_overlap_overlap;
-        }
+          communicationInterface(*g,cellOverlapOverlap,sendlist,recvlist);
       }
       if (codim==dim) // the vertices
       {
         if (iftype==InteriorBorder_InteriorBorder_Interface)
-        {
-          sendlist = &g->send_vertex_interiorborder_interiorborder;
-          recvlist = &g->recv_vertex_interiorborder_interiorborder;
-        }
-
+          communicationInterface(*g,vertexInteriorBorderInteriorBorder,sendlist,recvlist);
         if (iftype==InteriorBorder_All_Interface)
-        {
-          sendlist = &g->send_vertex_interiorborder_overlapfront;
-          recvlist = &g->recv_vertex_overlapfront_interiorborder;
-        }
+          communicationInterface(*g,vertexInteriorBorderOverlapFront,sendlist,recvlist);
         if (iftype==Overlap_OverlapFront_Interface || iftype==Overlap_All_Interface)
-        {
-          sendlist = &g->send_vertex_overlap_overlapfront;
-          recvlist = &g->recv_vertex_overlapfront_overlap;
-        }
+          communicationInterface(*g,vertexOverlapOverlapFront,sendlist,recvlist);
         if (iftype==All_All_Interface)
-        {
-          sendlist = &g->send_vertex_overlapfront_overlapfront;
-          recvlist = &g->recv_vertex_overlapfront_overlapfront;
-        }
+          communicationInterface(*g,vertexOverlapFrontOverlapFront,sendlist,recvlist);
       }
 
       // change communication direction?
@@ -1421,6 +1505,62 @@ namespace Dune {
       return leafIndexSet_;
     }
 
+    //! return true if the grid is periodic in direction i
+    bool isPeriodic (int i) const
+    {
+      return _periodic[i];
+    }
+
+    /*! @brief return the structured stencil of a grid level
+
+       The stencil provides the index offsets of neighboring cells and
+       vertices for the level index set.
+     */
+    YaspStencil<const YaspGrid<dim> > stencil (int level) const
+    {
+      if (level<0 || level>maxLevel()) DUNE_THROW(RangeError, "level out of range");
+      return YaspStencil<const YaspGrid<dim> >(*this,level);
+    }
+
+    //! return the structured stencil of the leaf grid (the finest level)
+    YaspStencil<const YaspGrid<dim> > leafStencil () const
+    {
+      return YaspStencil<const YaspGrid<dim> >(*this,maxLevel());
+    }
+
+    /*! @brief return the memory (in bytes) used by the description of a grid level
+
+       This includes the subgrids describing the level and the communication
+       interfaces computed so far, but neither the index sets nor the
+       geometries.
+     */
+    std::size_t memoryUsage (int level) const
+    {
+      YGridLevelIterator g = begin(level);
+      std::size_t intersections
+        = g->send_cell_overlap_overlap.capacity() + g->recv_cell_overlap_overlap.capacity()
+          + g->send_cell_interior_overlap.capacity() + g->recv_cell_overlap_interior.capacity()
+          + g->send_vertex_overlapfront_overlapfront.capacity() + g->recv_vertex_overlapfront_overlapfront.capacity()
+          + g->send_vertex_overlap_overlapfront.capacity() + g->recv_vertex_overlapfront_overlap.capacity()
+          + g->send_vertex_interiorborder_interiorborder.capacity() + g->recv_vertex_interiorborder_interiorborder.capacity()
+          + g->send_vertex_interiorborder_overlapfront.capacity() + g->recv_vertex_overlapfront_interiorborder.capacity();
+      return sizeof(YGridLevel) + intersections*sizeof(Intersection);
+    }
+
+    //! print the memory used by the description of each grid level
+    void printMemoryReport (std::ostream& s) const
+    {
+      std::size_t total = 0;
+      for (YGridLevelIterator g=begin(); g!=end(); ++g)
+      {
+        const std::size_t bytes = memoryUsage(g->level());
+        s << "level " << g->level() << ": " << bytes << " bytes ("
+          << g->interfaces.count() << " of " << g->interfaces.size() << " interfaces computed)" << std::endl;
+        total += bytes;
+      }
+      s << "total: " << total << " bytes" << std::endl;
+    }
+
 #if HAVE_MPI
     /*! @brief return a collective communication object
      */
@@ -1615,6 +1755,7 @@ namespace Dune {
     bool keep_ovlp;
     int adaptRefCount;
     bool adaptActive;
+    AdaptationStatistics adaptationStatistics_;
   };
 
   //! Output operator for multigrids
@@ -1634,25 +1775,25 @@ namespace Dune {
       s << "[" << rank << "]:   " << "cell_global=" << g->cell_global << std::endl;
       s << "[" << rank << "]:   " << "cell_overlap=" << g->cell_overlap << std::endl;
       s << "[" << rank << "]:   " << "cell_interior=" << g->cell_interior << std::endl;
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_cell_overlap_overlap.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_cell_overlap_overlap.begin();
            i!=g->send_cell_overlap_overlap.end(); ++i)
       {
         s << "[" << rank << "]:    " << " s_c_o_o "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_cell_overlap_overlap.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_cell_overlap_overlap.begin();
            i!=g->recv_cell_overlap_overlap.end(); ++i)
       {
         s << "[" << rank << "]:    " << " r_c_o_o "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_cell_interior_overlap.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_cell_interior_overlap.begin();
            i!=g->send_cell_interior_overlap.end(); ++i)
       {
         s << "[" << rank << "]:    " << " s_c_i_o "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_cell_overlap_interior.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_cell_overlap_interior.begin();
            i!=g->recv_cell_overlap_interior.end(); ++i)
       {
         s << "[" << rank << "]:    " << " r_c_o_i "
@@ -1665,49 +1806,49 @@ namespace Dune {
       s << "[" << rank << "]:   " << "vertex_overlap="        << g->vertex_overlap << std::endl;
       s << "[" << rank << "]:   " << "vertex_interiorborder=" << g->vertex_interiorborder << std::endl;
       s << "[" << rank << "]:   " << "vertex_interior="       << g->vertex_interior << std::endl;
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_vertex_overlapfront_overlapfront.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_vertex_overlapfront_overlapfront.begin();
            i!=g->send_vertex_overlapfront_overlapfront.end(); ++i)
       {
         s << "[" << rank << "]:    " << " s_v_of_of "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_vertex_overlapfront_overlapfront.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_vertex_overlapfront_overlapfront.begin();
            i!=g->recv_vertex_overlapfront_overlapfront.end(); ++i)
       {
         s << "[" << rank << "]:    " << " r_v_of_of "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_vertex_overlap_overlapfront.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_vertex_overlap_overlapfront.begin();
            i!=g->send_vertex_overlap_overlapfront.end(); ++i)
       {
         s << "[" << rank << "]:    " << " s_v_o_of "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_vertex_overlapfront_overlap.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_vertex_overlapfront_overlap.begin();
            i!=g->recv_vertex_overlapfront_overlap.end(); ++i)
       {
         s << "[" << rank << "]:    " << " r_v_of_o "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_vertex_interiorborder_interiorborder.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_vertex_interiorborder_interiorborder.begin();
            i!=g->send_vertex_interiorborder_interiorborder.end(); ++i)
       {
         s << "[" << rank << "]:    " << " s_v_ib_ib "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_vertex_interiorborder_interiorborder.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_vertex_interiorborder_interiorborder.begin();
            i!=g->recv_vertex_interiorborder_interiorborder.end(); ++i)
       {
         s << "[" << rank << "]:    " << " r_v_ib_ib "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_vertex_interiorborder_overlapfront.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->send_vertex_interiorborder_overlapfront.begin();
            i!=g->send_vertex_interiorborder_overlapfront.end(); ++i)
       {
         s << "[" << rank << "]:    " << " s_v_ib_of "
           << i->rank << " " << i->grid << std::endl;
       }
-      for (typename std::deque<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_vertex_overlapfront_interiorborder.begin();
+      for (typename std::vector<typename YaspGrid<d>::Intersection>::const_iterator i=g->recv_vertex_overlapfront_interiorborder.begin();
            i!=g->recv_vertex_overlapfront_interiorborder.end(); ++i)
       {
         s << "[" << rank << "]:    " << " s_v_of_ib "
@@ -15,18 +15,32 @@
 #if HAVE_MPI
 #include <mpi.h>
 #endif
+#include <stdint.h>
 #include <string.h>
 
 // local includes
 #include <dune/common/fvector.hh>
 #include <dune/common/stdstreams.hh>
 #include <dune/common/power.hh>
+#include <dune/common/shared_ptr.hh>
 #include <dune/grid/common/grid.hh>
 
 /** \file
     \brief This is the basis for the yaspgrid implementation of the Dune grid interface.
  */
 
+/** \brief exchange messages between processes on the same node through an MPI-3 shared memory window
+
+   See Torus::sharedMemoryExchange().
+ */
+#ifndef YASPGRID_SHARED_MEMORY_EXCHANGE
+#if HAVE_MPI && defined(MPI_VERSION) && (MPI_VERSION >= 3)
+#define YASPGRID_SHARED_MEMORY_EXCHANGE 1
+#else
+#define YASPGRID_SHARED_MEMORY_EXCHANGE 0
+#endif
+#endif
+
 namespace Dune {
 
   // forward declarations
@@ -866,6 +880,195 @@ namespace Dune {
       return SubIterator(*this,last);
     }
 
+    /*! TiledSubIterator is a SubIterator visiting the cells in a blocked order.
+
+       The subgrid is decomposed into tiles of a given size. The cells of a
+       tile are visited in lexicographic order before moving to the next
+       tile. The tiles are visited in lexicographic order or, optionally,
+       along a Morton (Z-order) curve. Stencil operations then work on data
+       of neighboring cells that is still in cache, even if a whole plane of
+       the subgrid does not fit into the cache.
+
+       Morton codes are 64 bit wide; construction throws a GridError if the
+       number of tiles does not fit. Codes of tiles outside the subgrid are
+       skipped in ranges, not one by one.
+
+       A TiledSubIterator compares equal to subend() after the last cell.
+     */
+    class TiledSubIterator : public SubIterator {
+      typedef uint64_t MortonCode;
+
+    public:
+      //! Make iterator pointing to first cell in subgrid.
+      TiledSubIterator (const SubYGrid<d,ct>& r, const iTupel& tileSize, bool morton=false)
+        : SubIterator(r), _endit(r.subend()), _tileSize(tileSize), _morton(morton), _code(0), _levels(0)
+      {
+        int maxTiles = 1;
+        for (int i=0; i<d; ++i)
+        {
+          assert(tileSize[i] > 0);
+          _numTiles[i] = (r.size(i)+tileSize[i]-1)/tileSize[i];
+          maxTiles = std::max(maxTiles,_numTiles[i]);
+          _tile[i] = 0;
+        }
+
+        // Morton codes cover the smallest power of two cube containing all tiles
+        while ((1 << _levels) < maxTiles) ++_levels;
+        if (_morton && d*_levels >= int(8*sizeof(MortonCode)))
+          DUNE_THROW(GridError, "TiledSubIterator: too many tiles for Morton order");
+
+        for (int i=0; i<d; ++i)
+          if (r.size(i) <= 0)
+          {
+            static_cast<SubIterator&>(*this) = _endit;
+            return;
+          }
+        setTile();
+      }
+
+      //! Make iterator from subiterator (used for automatic conversion of end)
+      TiledSubIterator (const SubIterator& i)
+        : SubIterator(i), _endit(i), _morton(false), _code(0), _levels(0)
+      {}
+
+      //! Increment iterator to next cell in subgrid
+      TiledSubIterator& operator++ ()
+      {
+        // move to next cell within the tile
+        for (int i=0; i<d; ++i)
+        {
+          if (this->_coord[i] < _tileEnd[i])
+          {
+            SubIterator::move(i,1);
+            return *this;
+          }
+          SubIterator::move(i,_tileOrigin[i]-this->_coord[i]);
+        }
+
+        // move to next tile
+        if (nextTile())
+          setTile();
+        else
+          static_cast<SubIterator&>(*this) = _endit;
+        return *this;
+      }
+
+    private:
+      // advance _tile, return false if there are no more tiles
+      bool nextTile ()
+      {
+        if (!_morton)
+        {
+          for (int i=0; i<d; ++i)
+          {
+            if (++_tile[i] < _numTiles[i])
+              return true;
+            _tile[i] = 0;
+          }
+          return false;
+        }
+
+        // jump to the next Morton code of a tile inside the subgrid
+        const MortonCode next = _code+1;
+        if ((next >> (d*_levels)) != 0 || !nextInside(next,_code))
+          return false;
+        for (int i=0; i<d; ++i)
+        {
+          _tile[i] = 0;
+          for (int b=0; b<_levels; ++b)
+            _tile[i] |= int((_code >> (d*b+i)) & 1) << b;
+        }
+        return true;
+      }
+
+      // bits of direction i below bit b of this direction in a Morton code
+      static MortonCode lowerBits (int i, int b)
+      {
+        MortonCode mask = 0;
+        for (int c=0; c<b; ++c)
+          mask |= MortonCode(1) << (d*c+i);
+        return mask;
+      }
+
+      /* find the smallest Morton code not less than z, whose tile lies inside
+         the subgrid, i.e., in the box spanned by the codes of the first and
+         the last tile (BIGMIN algorithm of Tropf and Herzog). Ranges of codes
+         outside the box are skipped without visiting them. */
+      bool nextInside (MortonCode z, MortonCode& next) const
+      {
+        MortonCode zmin = 0;
+        MortonCode zmax = 0;
+        for (int b=0; b<_levels; ++b)
+          for (int i=0; i<d; ++i)
+            zmax |= MortonCode(((_numTiles[i]-1) >> b) & 1) << (d*b+i);
+
+        bool found = false;
+        for (int p=d*_levels-1; p>=0; --p)
+        {
+          const int i = p % d;
+          const int b = p / d;
+          const MortonCode bit = MortonCode(1) << p;
+          const bool zBit = (z & bit) != 0;
+          const bool minBit = (zmin & bit) != 0;
+          const bool maxBit = (zmax & bit) != 0;
+          if (!zBit && !minBit && maxBit)
+          {
+            // candidate in the upper half, continue in the lower half
+            next = (zmin & ~lowerBits(i,b)) | bit;
+            found = true;
+            zmax = (zmax & ~bit) | lowerBits(i,b);
+          }
+          else if (!zBit && minBit)
+          {
+            // the whole remaining box lies above z
+            next = zmin;
+            return true;
+          }
+          else if (zBit && !maxBit)
+          {
+            // the whole remaining box lies below z
+            return found;
+          }
+          else if (zBit && !minBit)
+          {
+            // continue in the upper half
+            zmin = (zmin & ~lowerBits(i,b)) | bit;
+          }
+        }
+
+        // z itself lies inside the box
+        next = z;
+        return true;
+      }
+
+      // move to first cell of the current tile
+      void setTile ()
+      {
+        for (int i=0; i<d; ++i)
+        {
+          _tileOrigin[i] = this->_origin[i] + _tile[i]*_tileSize[i];
+          _tileEnd[i] = std::min(_tileOrigin[i]+_tileSize[i]-1,this->_end[i]);
+          SubIterator::move(i,_tileOrigin[i]-this->_coord[i]);
+        }
+      }
+
+      SubIterator _endit;  //!< end iterator of the subgrid
+      iTupel _tileSize;    //!< number of cells of a tile per direction
+      iTupel _numTiles;    //!< number of tiles per direction
+      iTupel _tile;        //!< current tile
+      iTupel _tileOrigin;  //!< first cell of the current tile
+      iTupel _tileEnd;     //!< last cell of the current tile
+      bool _morton;        //!< traverse tiles in Morton order
+      MortonCode _code;    //!< Morton code of the current tile
+      int _levels;         //!< number of bits per direction of a Morton code
+    };
+
+    //! return tiled subiterator to first element of index set
+    TiledSubIterator tiledsubbegin (const iTupel& tileSize, bool morton=false) const
+    {
+      return TiledSubIterator(*this,tileSize,morton);
+    }
+
     /*! TransformingSubIterator is a SubIterator providing in addition a linear transformation
        of the coordinates of the grid in the form \f$ y_i = x_i h_i + s_i \f$.
        This can be used to interpret the grid cells as vertices, edges, faces, etc.
@@ -1105,6 +1308,159 @@ namespace Dune {
     }
   };
 
+  /** \brief Implement a yaspgrid load balance strategy minimizing communication
+
+     All tensor product decompositions of the P processes are considered.
+     Directions not divisible by the number of processes are split into
+     pieces differing by one cell (see Torus::partition). The decomposition
+     minimizing the estimated cost
+
+     \f[ n_{max} + w \left( h + w_{node} \frac{h_{node}}{R} \right) \f]
+
+     is chosen, where \f$n_{max}\f$ is the largest number of cells on a
+     process and \f$h\f$ is the largest number of halo cells a process
+     exchanges with its face neighbors. The halo takes the overlap width into
+     account, as well as the fact that processes at non-periodic boundaries
+     have fewer neighbors.
+
+     If R ranks share a node, the ranks are assumed to be placed on the nodes
+     in consecutive blocks. Since Torus numbers the processes with the first
+     direction running fastest, each node then holds a block of the process
+     torus, and \f$h_{node}\f$ estimates the halo of such a block, i.e., the
+     volume of inter-node communication.
+
+     \note Since Torus arranges the processes in a tensor product grid, only
+           the number of processes per direction can be chosen. Uneven
+           splits only occur within a direction, so a prime P still yields a
+           P x 1 x ... x 1 slab decomposition.
+   */
+  template<int d>
+  class YLoadBalanceSurface : public YLoadBalance<d>
+  {
+  public:
+    typedef FieldVector<int, d>  iTupel;
+
+    /** \brief constructor
+
+       \param overlap       overlap width of the grid (in cells of the coarse grid)
+       \param periodic      periodicity of the grid
+       \param ranksPerNode  number of consecutive ranks sharing a node
+       \param commWeight    weight w of a halo cell relative to an interior cell
+       \param nodeWeight    weight w_node of an inter-node halo cell relative to
+                            an intra-node halo cell
+     */
+    YLoadBalanceSurface (int overlap = 1, std::bitset<d> periodic = std::bitset<d>(), int ranksPerNode = 1,
+                         double commWeight = 1.0, double nodeWeight = 4.0)
+      : _overlap(overlap), _periodic(periodic), _ranksPerNode(ranksPerNode),
+        _commWeight(commWeight), _nodeWeight(nodeWeight)
+    {}
+
+    virtual void loadbalance (const iTupel& size, int P, iTupel& dims) const
+    {
+      double opt=1E100;
+      iTupel trydims;
+
+      optimize_dims(d-1,size,P,dims,trydims,opt);
+    }
+
+    //! estimated cost of a decomposition of a grid with given size into dims processes
+    double cost (const iTupel& size, const iTupel& dims) const
+    {
+      iTupel extent;       // maximum number of cells of a process
+      iTupel block;        // number of processes of a node
+      iTupel nodeExtent;   // maximum number of cells of a node
+      iTupel nodes;        // number of nodes
+      double cells = 1.0;
+      int r = _ranksPerNode;
+      for (int k=0; k<d; k++)
+      {
+        extent[k] = (size[k]+dims[k]-1)/dims[k];
+        cells *= extent[k];
+
+        // fill the nodes with consecutive ranks (first direction fastest)
+        if (dims[k]%r == 0)
+        {
+          block[k] = r;
+          r = 1;
+        }
+        else if (r%dims[k] == 0)
+        {
+          block[k] = dims[k];
+          r /= dims[k];
+        }
+        else
+        {
+          // nodes do not form regular blocks, estimate by the largest common divisor
+          int a = r, b = dims[k];
+          while (b != 0) { const int t = a%b; a = b; b = t; }
+          block[k] = a;
+          r = 1;
+        }
+        nodeExtent[k] = block[k]*extent[k];
+        nodes[k] = dims[k]/block[k];
+      }
+
+      double h = halo(extent,dims);
+      double hNode = 0.0;
+      if (_ranksPerNode > 1)
+        hNode = halo(nodeExtent,nodes)/_ranksPerNode;
+      return cells + _commWeight*(h + _nodeWeight*hNode);
+    }
+
+  private:
+    // largest number of halo cells of a box with given extent in a torus with given number of boxes
+    double halo (const iTupel& extent, const iTupel& boxes) const
+    {
+      double h = 0.0;
+      for (int k=0; k<d; k++)
+      {
+        // number of face neighbors in direction k
+        int faces = 2;
+        if (!_periodic[k] && boxes[k] <= 2)
+          faces = boxes[k]-1;
+
+        double face = faces*_overlap;
+        for (int j=0; j<d; j++)
+          if (j != k)
+            face *= extent[j];
+        h += face;
+      }
+      return h;
+    }
+
+    void optimize_dims (int i, const iTupel& size, int P, iTupel& dims, iTupel& trydims, double &opt ) const
+    {
+      if (i>0) // test all subdivisions recursively
+      {
+        for (int k=1; k<=P; k++)
+          if (P%k==0)
+          {
+            // P divisible by k
+            trydims[i] = k;
+            optimize_dims(i-1,size,P/k,dims,trydims,opt);
+          }
+      }
+      else
+      {
+        // found a possible combination
+        trydims[0] = P;
+
+        const double m = cost(size,trydims);
+        if (m<opt)
+        {
+          opt = m;
+          dims = trydims;
+        }
+      }
+    }
+
+    int _overlap;
+    std::bitset<d> _periodic;
+    int _ranksPerNode;
+    double _commWeight;
+    double _nodeWeight;
+  };
+
   /*! Torus provides all the functionality to handle a toroidal communication structure:
 
      - Map a set of processes (given by an MPI communicator) to a torus of dimension d. The "optimal"
@@ -1530,6 +1886,12 @@ namespace Dune {
       _localsendrequests.clear();
       _localrecvrequests.clear();
 
+#if YASPGRID_SHARED_MEMORY_EXCHANGE
+      // handle requests of processes on the same node through shared memory
+      if (_shared.get())
+        exchangeShared();
+#endif
+
 #if HAVE_MPI
       // handle foreign requests
       int sends=0;
@@ -1598,6 +1960,40 @@ namespace Dune {
 #endif
     }
 
+    /** \brief exchange messages between processes on the same node through shared memory
+
+       If enabled, messages to processes on the same shared memory node are
+       not passed to MPI_Isend/MPI_Irecv. Instead, the sender copies them into
+       its segment of a window allocated by MPI_Win_allocate_shared and the
+       receivers copy them directly out of this segment. This avoids the
+       matching and the intermediate buffers of the MPI library for on-node
+       neighbors. Messages to other nodes are still sent through MPI.
+
+       \note This method is collective. While enabled, exchange() synchronizes
+             all processes on a node, so all processes of the communicator
+             have to call exchange() together (as YaspGrid does).
+       \note Requires MPI-3; otherwise this method does nothing.
+     */
+    void sharedMemoryExchange (bool enable)
+    {
+#if YASPGRID_SHARED_MEMORY_EXCHANGE
+      if (enable && !_shared.get())
+        _shared = shared_ptr<SharedWindow>(new SharedWindow(_comm));
+      else if (!enable)
+        _shared = shared_ptr<SharedWindow>();
+#endif
+    }
+
+    //! return true if messages to processes on the same node are exchanged through shared memory
+    bool sharedMemoryExchange () const
+    {
+#if YASPGRID_SHARED_MEMORY_EXCHANGE
+      return (_shared.get() != 0);
+#else
+      return false;
+#endif
+    }
+
     //! global max
     double global_max (double x) const
     {
@@ -1700,6 +2096,203 @@ namespace Dune {
     mutable std::vector<CommTask> _localsendrequests;
     mutable std::vector<CommTask> _localrecvrequests;
 
+#if YASPGRID_SHARED_MEMORY_EXCHANGE
+    // shared memory window of the processes on one node
+    struct SharedWindow
+    {
+      // record describing a message in a segment
+      struct Message
+      {
+        int rank;  // rank of the receiver in the torus communicator
+        int size;  // size of the message
+      };
+
+      explicit SharedWindow (MPI_Comm comm)
+        : win(MPI_WIN_NULL), capacity(0)
+      {
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodecomm);
+        int nodeprocs;
+        MPI_Comm_size(nodecomm, &nodeprocs);
+        segments.resize(nodeprocs, 0);
+
+        // map ranks in comm to ranks in nodecomm (MPI_UNDEFINED if not on this node)
+        int procs;
+        MPI_Comm_size(comm, &procs);
+        std::vector<int> ranks(procs);
+        for (int i=0; i<procs; i++)
+          ranks[i] = i;
+        noderank.resize(procs);
+        MPI_Group group, nodegroup;
+        MPI_Comm_group(comm, &group);
+        MPI_Comm_group(nodecomm, &nodegroup);
+        MPI_Group_translate_ranks(group, procs, &ranks[0], nodegroup, &noderank[0]);
+        MPI_Group_free(&group);
+        MPI_Group_free(&nodegroup);
+      }
+
+      ~SharedWindow ()
+      {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (finalized)
+          return;
+        release();
+        MPI_Comm_free(&nodecomm);
+      }
+
+      // make each segment hold at least the given number of bytes; collective on the node
+      std::size_t reserve (std::size_t bytes)
+      {
+        unsigned long mine = bytes, needed;
+        MPI_Allreduce(&mine, &needed, 1, MPI_UNSIGNED_LONG, MPI_MAX, nodecomm);
+        if (needed > capacity)
+        {
+          release();
+          capacity = std::max(std::size_t(needed), 2*capacity);
+          char* base;
+          MPI_Win_allocate_shared(capacity, 1, MPI_INFO_NULL, nodecomm, &base, &win);
+          for (unsigned int r=0; r<segments.size(); r++)
+          {
+            MPI_Aint size;
+            int dispunit;
+            MPI_Win_shared_query(win, r, &size, &dispunit, &(segments[r]));
+          }
+          MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+        }
+        return needed;
+      }
+
+      // make the segments written by the processes on the node visible to all of them
+      void sync ()
+      {
+        MPI_Win_sync(win);
+        MPI_Barrier(nodecomm);
+        MPI_Win_sync(win);
+      }
+
+      void release ()
+      {
+        if (win == MPI_WIN_NULL)
+          return;
+        MPI_Win_unlock_all(win);
+        MPI_Win_free(&win);
+        capacity = 0;
+      }
+
+      MPI_Comm nodecomm;
+      std::vector<int> noderank;
+      MPI_Win win;
+      std::size_t capacity;
+      std::vector<char*> segments;
+    };
+
+    // is the process in the torus communicator on the same node (and not this process)?
+    bool onNode (int rank) const
+    {
+      return (rank != _rank) && (_shared->noderank[rank] != MPI_UNDEFINED);
+    }
+
+    /* exchange the requests to and from processes on the same node
+
+       Each segment starts with the number of messages, followed by a record
+       (receiver, size) for each message and the message data in the same
+       order. As for MPI, messages between two processes are received in the
+       order they were sent.
+     */
+    void exchangeShared () const
+    {
+      typedef typename SharedWindow::Message Message;
+      SharedWindow& shared = *_shared;
+
+      // size of the on-node messages
+      int count = 0;
+      std::size_t bytes = 0;
+      for (unsigned int i=0; i<_sendrequests.size(); i++)
+        if (onNode(_sendrequests[i].rank))
+        {
+          ++count;
+          bytes += _sendrequests[i].size;
+        }
+
+      // all processes on the node agree whether there is anything to do;
+      // a process without on-node messages only needs room for the count
+      // if some other process on the node sends something
+      const std::size_t size = (count > 0 ? sizeof(int) + count*sizeof(Message) + bytes : 0);
+      if (shared.reserve(size) == 0)
+        return;
+
+      // copy on-node messages into own segment
+      char* segment = shared.segments[shared.noderank[_rank]];
+      memcpy(segment, &count, sizeof(int));
+      Message* messages = reinterpret_cast<Message*>(segment + sizeof(int));
+      char* data = segment + sizeof(int) + count*sizeof(Message);
+      std::vector<CommTask> sendrequests;
+      for (unsigned int i=0; i<_sendrequests.size(); i++)
+      {
+        const CommTask& task = _sendrequests[i];
+        if (!onNode(task.rank))
+        {
+          sendrequests.push_back(task);
+          continue;
+        }
+        Message message;
+        message.rank = task.rank;
+        message.size = task.size;
+        memcpy(messages++, &message, sizeof(Message));
+        memcpy(data, task.buffer, task.size);
+        data += task.size;
+      }
+      _sendrequests.swap(sendrequests);
+
+      shared.sync();
+
+      // copy on-node messages out of the senders' segments
+      std::vector<int> next(shared.segments.size(), 0);
+      std::vector<std::size_t> offset(shared.segments.size(), 0);
+      std::vector<CommTask> recvrequests;
+      for (unsigned int i=0; i<_recvrequests.size(); i++)
+      {
+        const CommTask& task = _recvrequests[i];
+        if (!onNode(task.rank))
+        {
+          recvrequests.push_back(task);
+          continue;
+        }
+
+        const int source = shared.noderank[task.rank];
+        const char* segment = shared.segments[source];
+        int messages;
+        memcpy(&messages, segment, sizeof(int));
+        const char* data = segment + sizeof(int) + messages*sizeof(Message);
+        Message message;
+        for (; next[source]<messages; next[source]++)
+        {
+          memcpy(&message, segment + sizeof(int) + next[source]*sizeof(Message), sizeof(Message));
+          if (message.rank == _rank)
+            break;
+          offset[source] += message.size;
+        }
+        if (next[source] == messages)
+        {
+          std::cout << "[" << rank() << "]: ERROR: no shared memory message from " << task.rank << " in exchange!" << std::endl;
+          continue;
+        }
+        if (message.size != task.size)
+          std::cout << "[" << rank() << "]: ERROR: size in shared memory send/receive does not match in exchange!" << std::endl;
+        else
+          memcpy(task.buffer, data + offset[source], task.size);
+        offset[source] += message.size;
+        next[source]++;
+      }
+      _recvrequests.swap(recvrequests);
+
+      // the segments may be overwritten once all receivers are done
+      shared.sync();
+    }
+
+    shared_ptr<SharedWindow> _shared;
+#endif
+
   };
 
   //! Output operator for Torus
@@ -11,13 +11,18 @@
    We have specializations for dim == dimworld (elements) and dim == 0
    (vertices).  The general version implements dim == dimworld-1 (faces)
    and otherwise throws a GridError.
+
+   All specializations derive from BatchedAxisAlignedCubeGeometry and thus
+   provide batched evaluation of global() and integrationElement().
  */
 
+#include <dune/grid/common/batchedgeometry.hh>
+
 namespace Dune {
 
   //! The general version can do any dimension, but constructors currently exist only for dim==dimworld-1
   template<int mydim,int cdim, class GridImp>
-  class YaspGeometry : public AxisAlignedCubeGeometry<typename GridImp::ctype,mydim,cdim>
+  class YaspGeometry : public BatchedAxisAlignedCubeGeometry<typename GridImp::ctype,mydim,cdim>
   {
   public:
     //! define type used for coordinates in grid module
@@ -25,12 +30,12 @@ namespace Dune {
 
     //! default constructor
     YaspGeometry ()
-      : AxisAlignedCubeGeometry<ctype,mydim,cdim>(FieldVector<ctype,cdim>(0),FieldVector<ctype,cdim>(0)) // anything
+      : BatchedAxisAlignedCubeGeometry<ctype,mydim,cdim>(FieldVector<ctype,cdim>(0),FieldVector<ctype,cdim>(0)) // anything
     {}
 
     //! constructor from midpoint and extension and missing direction number
     YaspGeometry (const FieldVector<ctype, cdim>& p, const FieldVector<ctype, cdim>& h, uint8_t& m)
-      : AxisAlignedCubeGeometry<ctype,mydim,cdim>(FieldVector<ctype,cdim>(0),FieldVector<ctype,cdim>(0)) // anything
+      : BatchedAxisAlignedCubeGeometry<ctype,mydim,cdim>(FieldVector<ctype,cdim>(0),FieldVector<ctype,cdim>(0)) // anything
     {
       if (cdim!=mydim+1)
         DUNE_THROW(GridError, "This YaspGeometry constructor assumes cdim=mydim+1");
@@ -51,7 +56,7 @@ namespace Dune {
 
     //! copy constructor
     YaspGeometry (const YaspGeometry& other)
-      : AxisAlignedCubeGeometry<ctype,mydim,cdim>(other)
+      : BatchedAxisAlignedCubeGeometry<ctype,mydim,cdim>(other)
     {}
 
     //! print function
@@ -73,19 +78,19 @@ namespace Dune {
 
   //! specialize for dim=dimworld, i.e. a volume element
   template<int mydim, class GridImp>
-  class YaspGeometry<mydim,mydim,GridImp> : public AxisAlignedCubeGeometry<typename GridImp::ctype,mydim,mydim>
+  class YaspGeometry<mydim,mydim,GridImp> : public BatchedAxisAlignedCubeGeometry<typename GridImp::ctype,mydim,mydim>
   {
   public:
     typedef typename GridImp::ctype ctype;
 
     //! default constructor
     YaspGeometry ()
-      : AxisAlignedCubeGeometry<ctype,mydim,mydim>(FieldVector<ctype,mydim>(0),FieldVector<ctype,mydim>(0)) // anything
+      : BatchedAxisAlignedCubeGeometry<ctype,mydim,mydim>(FieldVector<ctype,mydim>(0),FieldVector<ctype,mydim>(0)) // anything
     {}
 
     //! constructor from midpoint and extension
     YaspGeometry (const FieldVector<ctype, mydim>& p, const FieldVector<ctype, mydim>& h)
-      : AxisAlignedCubeGeometry<ctype,mydim,mydim>(FieldVector<ctype,mydim>(0),FieldVector<ctype,mydim>(0)) // anything
+      : BatchedAxisAlignedCubeGeometry<ctype,mydim,mydim>(FieldVector<ctype,mydim>(0),FieldVector<ctype,mydim>(0)) // anything
     {
       FieldVector<ctype, mydim> lower = p;
       FieldVector<ctype, mydim> upper = p;
@@ -97,7 +102,7 @@ namespace Dune {
 
     //! copy constructor (skipping temporary variables)
     YaspGeometry (const YaspGeometry& other)
-      : AxisAlignedCubeGeometry<ctype,mydim,mydim>(other)
+      : BatchedAxisAlignedCubeGeometry<ctype,mydim,mydim>(other)
     {}
 
     //! print function
@@ -116,23 +121,23 @@ namespace Dune {
 
   //! specialization for dim=0, this is a vertex
   template<int cdim, class GridImp>
-  class YaspGeometry<0,cdim,GridImp> : public AxisAlignedCubeGeometry<typename GridImp::ctype,0,cdim>
+  class YaspGeometry<0,cdim,GridImp> : public BatchedAxisAlignedCubeGeometry<typename GridImp::ctype,0,cdim>
   {
   public:
     typedef typename GridImp::ctype ctype;
 
     //! default constructor
     YaspGeometry ()
-      : AxisAlignedCubeGeometry<typename GridImp::ctype,0,cdim>(FieldVector<ctype,cdim>(0)) // anything
+      : BatchedAxisAlignedCubeGeometry<typename GridImp::ctype,0,cdim>(FieldVector<ctype,cdim>(0)) // anything
     {}
 
     //! constructor
     explicit YaspGeometry ( const FieldVector< ctype, cdim > &p )
-      : AxisAlignedCubeGeometry<typename GridImp::ctype,0,cdim>( p )
+      : BatchedAxisAlignedCubeGeometry<typename GridImp::ctype,0,cdim>( p )
     {}
 
     YaspGeometry ( const FieldVector< ctype, cdim > &p, const FieldVector< ctype, cdim > &, uint8_t &)
-      : AxisAlignedCubeGeometry<typename GridImp::ctype,0,cdim>( p )
+      : BatchedAxisAlignedCubeGeometry<typename GridImp::ctype,0,cdim>( p )
     {}
 
     //! print function
@@ -0,0 +1,238 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_YASPGRIDSTENCIL_HH
+#define DUNE_GRID_YASPGRIDSTENCIL_HH
+
+/** \file
+ *
+   \brief direct index access to the neighbors of YaspGrid cells
+ */
+
+namespace Dune {
+
+  /** \brief structured stencil of a YaspGrid level
+   *
+   *  The cells (vertices) of a YaspGrid level are numbered lexicographically
+   *  on each process, with the first direction running fastest. The level
+   *  index of a face neighbor therefore differs from the index of the cell
+   *  by a constant offset, the stride of the direction. This class provides
+   *  these offsets, so that finite volume or finite difference kernels can
+   *  access neighbors without intersection iterators:
+   *  \code
+   *  YaspStencil< const YaspGrid< 2 > > stencil = grid.leafStencil();
+   *  for( int y = stencil.origin( 1 )+1; y < stencil.origin( 1 )+stencil.extent( 1 )-1; ++y )
+   *  {
+   *    const int first = stencil.index( stencil.origin( 0 )+1, y );
+   *    const int last = first + stencil.extent( 0 )-2;
+   *    for( int i = first; i < last; ++i )
+   *      v[ i ] = u[ i-1 ] + u[ i+1 ] + u[ i-stencil.stride( 1 ) ] + u[ i+stencil.stride( 1 ) ] - 4*u[ i ];
+   *  }
+   *  \endcode
+   *
+   *  All indices coincide with the level (leaf) index set for codimension 0
+   *  and dimension. Faces are numbered as by Intersection::indexInInside(),
+   *  i.e., face 2*i (2*i+1) is the lower (upper) face in direction i.
+   *  Corners are numbered as in the cube reference element. Coordinates are
+   *  the global logical coordinates of the cells (vertices) on the level.
+   *
+   *  Sweeps over large subdomains can be blocked for cache reuse by
+   *  traversing the cells with tiledBegin() instead of a plain loop:
+   *  \code
+   *  typedef YaspStencil< const YaspGrid< 3 > > Stencil;
+   *  const Stencil::TiledIterator end = stencil.tiledEnd();
+   *  for( Stencil::TiledIterator it = stencil.tiledBegin( tileSize ); it != end; ++it )
+   *    apply( it.superindex() );
+   *  \endcode
+   *
+   *  \note The stencil is invalidated by refinement and load balancing.
+   *
+   *  \tparam GridImp  YaspGrid this stencil belongs to
+   */
+  template< class GridImp >
+  class YaspStencil
+  {
+    typedef typename GridImp::YGridLevelIterator YGLI;
+
+  public:
+    enum { dim = GridImp::dimension };
+
+    typedef typename GridImp::ctype ctype;
+
+    //! type of (logical) coordinates
+    typedef FieldVector< int, dim > iTupel;
+
+    //! iterator over the cells in blocked order (superindex() returns the index)
+    typedef typename SubYGrid< dim, ctype >::TiledSubIterator TiledIterator;
+
+    //! index returned for neighbors not present on this process
+    static const int invalid = -1;
+
+    YaspStencil ( const GridImp &grid, int level )
+    {
+      const YGLI g = grid.begin( level );
+      cells_ = g->cell_overlap;
+
+      int cellStride = 1, vertexStride = 1;
+      for( int i = 0; i < dim; ++i )
+      {
+        origin_[ i ] = g->cell_overlap.origin( i );
+        extent_[ i ] = g->cell_overlap.size( i );
+        globalOrigin_[ i ] = g->cell_global.origin( i );
+        globalExtent_[ i ] = g->cell_global.size( i );
+        periodic_[ i ] = grid.isPeriodic( i );
+
+        assert( g->vertex_overlapfront.origin( i ) == origin_[ i ] );
+        assert( g->vertex_overlapfront.size( i ) == extent_[ i ]+1 );
+
+        stride_[ i ] = cellStride;
+        vertexStride_[ i ] = vertexStride;
+        cellStride *= extent_[ i ];
+        vertexStride *= extent_[ i ]+1;
+      }
+      size_ = cellStride;
+
+      for( int c = 0; c < (1 << dim); ++c )
+      {
+        cornerOffset_[ c ] = 0;
+        for( int i = 0; i < dim; ++i )
+          cornerOffset_[ c ] += ((c >> i) & 1) * vertexStride_[ i ];
+      }
+    }
+
+    //! number of cells on this process (size of the index set for codimension 0)
+    int size () const { return size_; }
+
+    //! logical coordinate of the first cell on this process in direction i
+    int origin ( int i ) const { return origin_[ i ]; }
+
+    //! number of cells on this process in direction i
+    int extent ( int i ) const { return extent_[ i ]; }
+
+    //! index offset between neighboring cells in direction i
+    int stride ( int i ) const { return stride_[ i ]; }
+
+    //! index offset between neighboring vertices in direction i
+    int vertexStride ( int i ) const { return vertexStride_[ i ]; }
+
+    //! index offset of the neighbor behind a face
+    int faceOffset ( int face ) const
+    {
+      return ((face & 1) ? stride_[ face/2 ] : -stride_[ face/2 ]);
+    }
+
+    //! index offset of a corner relative to corner 0 of a cell
+    int cornerOffset ( int corner ) const { return cornerOffset_[ corner ]; }
+
+    //! index of the cell with the given logical coordinate
+    int index ( const iTupel &coord ) const
+    {
+      int index = 0;
+      for( int i = 0; i < dim; ++i )
+        index += (coord[ i ] - origin_[ i ]) * stride_[ i ];
+      return index;
+    }
+
+    //! index of the cell with logical coordinate (x,y) (only for dim = 2)
+    int index ( int x, int y ) const
+    {
+      assert( dim == 2 );
+      return (x - origin_[ 0 ]) + (y - origin_[ 1 ]) * stride_[ dim-1 ];
+    }
+
+    //! index of the cell with logical coordinate (x,y,z) (only for dim = 3)
+    int index ( int x, int y, int z ) const
+    {
+      assert( dim == 3 );
+      return (x - origin_[ 0 ]) + (y - origin_[ 1 ]) * stride_[ 1 ] + (z - origin_[ 2 ]) * stride_[ dim-1 ];
+    }
+
+    //! logical coordinate of a cell
+    iTupel coord ( int index ) const
+    {
+      iTupel coord;
+      for( int i = dim-1; i >= 0; --i )
+      {
+        coord[ i ] = origin_[ i ] + index / stride_[ i ];
+        index %= stride_[ i ];
+      }
+      return coord;
+    }
+
+    /** \brief return true if a face of a cell lies on the domain boundary
+     *
+     *  As for YaspIntersection::boundary(), faces on periodic boundaries are
+     *  boundary faces, too.
+     */
+    bool boundary ( int index, int face ) const
+    {
+      const int i = face/2;
+      const int c = coord( index, i ) + ((face & 1) ? 1 : -1);
+      return (c < globalOrigin_[ i ]) || (c >= globalOrigin_[ i ] + globalExtent_[ i ]);
+    }
+
+    /** \brief index of the neighbor behind a face
+     *
+     *  If the neighbor is not stored on this process, but the direction is
+     *  periodic and this process holds all cells of the direction, the
+     *  periodic image of the neighbor is returned. Otherwise, \c invalid is
+     *  returned.
+     */
+    int neighbor ( int index, int face ) const
+    {
+      const int i = face/2;
+      const int c = coord( index, i ) + ((face & 1) ? 1 : -1);
+      if( (c >= origin_[ i ]) && (c < origin_[ i ] + extent_[ i ]) )
+        return index + faceOffset( face );
+
+      if( periodic_[ i ] && (extent_[ i ] >= globalExtent_[ i ]) )
+        return index + (face & 1 ? 1 - globalExtent_[ i ] : globalExtent_[ i ] - 1) * stride_[ i ];
+      return invalid;
+    }
+
+    //! index of a corner (vertex) of a cell
+    int vertex ( int index, int corner ) const
+    {
+      int vertex = 0;
+      for( int i = dim-1; i >= 0; --i )
+      {
+        vertex += (index / stride_[ i ]) * vertexStride_[ i ];
+        index %= stride_[ i ];
+      }
+      return vertex + cornerOffset_[ corner ];
+    }
+
+    /** \brief iterator to the first cell of a blocked traversal
+     *
+     *  \param[in]  tileSize  number of cells of a tile in each direction
+     *  \param[in]  morton    traverse the tiles along a Morton curve instead
+     *                        of lexicographically
+     */
+    TiledIterator tiledBegin ( const iTupel &tileSize, bool morton = false ) const
+    {
+      return cells_.tiledsubbegin( tileSize, morton );
+    }
+
+    //! iterator behind the last cell of a blocked traversal
+    TiledIterator tiledEnd () const
+    {
+      return TiledIterator( cells_.subend() );
+    }
+
+  private:
+    // logical coordinate of a cell in direction i
+    int coord ( int index, int i ) const
+    {
+      return origin_[ i ] + (index / stride_[ i ]) % extent_[ i ];
+    }
+
+    SubYGrid< dim, ctype > cells_;
+    iTupel origin_, extent_, globalOrigin_, globalExtent_;
+    iTupel stride_, vertexStride_;
+    int size_;
+    std::bitset< dim > periodic_;
+    int cornerOffset_[ 1 << dim ];
+  };
+
+}  // namespace Dune
+
+#endif  // DUNE_GRID_YASPGRIDSTENCIL_HH
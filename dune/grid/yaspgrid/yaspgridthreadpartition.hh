@@ -0,0 +1,126 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_YASPGRIDTHREADPARTITION_HH
+#define DUNE_GRID_YASPGRIDTHREADPARTITION_HH
+
+/** \file
+ *
+   \brief decomposition of the cells of a YaspGrid process into boxes for threads
+ */
+
+namespace Dune {
+
+  /** \brief decomposition of the interior cells of a YaspGrid level into boxes
+   *
+   *  For hybrid parallelization, one process per node can own a large
+   *  subdomain, which is then split into boxes processed by the threads of
+   *  the node. The boxes are SubYGrids of the cells stored on this process,
+   *  so the superindex() of their iterators is the level (leaf) index of a
+   *  cell. Neighboring boxes share the memory of the process. Halo values
+   *  between boxes therefore need neither copies nor messages; only the
+   *  process boundaries are exchanged by communicate(), with one message per
+   *  neighboring process instead of one per neighboring box.
+   *  \code
+   *  YaspThreadPartition< const YaspGrid< 3 > > partition( grid, grid.maxLevel(), omp_get_max_threads() );
+   *  #pragma omp parallel for
+   *  for( int t = 0; t < partition.size(); ++t )
+   *  {
+   *    typedef YaspThreadPartition< const YaspGrid< 3 > >::Box Box;
+   *    const Box &box = partition.box( t );
+   *    if( box.empty() )
+   *      continue;
+   *    for( Box::SubIterator it = box.subbegin(); it != box.subend(); ++it )
+   *      apply( it.superindex() );
+   *  }
+   *  \endcode
+   *
+   *  The boxes are arranged as a tensor product chosen by a YLoadBalance, and
+   *  each direction is split into pieces differing by at most one cell (as
+   *  done by Torus::partition for the processes). Boxes may be empty if
+   *  there are more threads than cells in some direction.
+   *
+   *  \note The partition is invalidated by refinement and load balancing.
+   *
+   *  \tparam GridImp  YaspGrid this partition belongs to
+   */
+  template< class GridImp >
+  class YaspThreadPartition
+  {
+    typedef typename GridImp::YGridLevelIterator YGLI;
+
+  public:
+    enum { dim = GridImp::dimension };
+
+    typedef typename GridImp::ctype ctype;
+
+    //! type of (logical) coordinates
+    typedef FieldVector< int, dim > iTupel;
+
+    //! type of the boxes (subgrids of the cells stored on this process)
+    typedef SubYGrid< dim, ctype > Box;
+
+    /** \brief constructor
+     *
+     *  \param[in]  grid        YaspGrid to decompose
+     *  \param[in]  level       grid level to decompose
+     *  \param[in]  numThreads  number of boxes
+     *  \param[in]  lb          load balancer choosing the arrangement of the boxes
+     */
+    YaspThreadPartition ( const GridImp &grid, int level, int numThreads,
+                          const YLoadBalance< dim > *lb = GridImp::defaultLoadbalancer() )
+    {
+      assert( numThreads > 0 );
+
+      const YGLI g = grid.begin( level );
+      const SubYGrid< dim, ctype > &interior = g->cell_interior;
+
+      const iTupel size = interior.size();
+      lb->loadbalance( size, numThreads, dims_ );
+
+      boxes_.reserve( numThreads );
+      iTupel coord( 0 );
+      for( int t = 0; t < numThreads; ++t )
+      {
+        iTupel origin, extent, offset;
+        for( int i = 0; i < dim; ++i )
+        {
+          const int m = size[ i ] / dims_[ i ];
+          const int r = size[ i ] % dims_[ i ];
+          const int first = coord[ i ]*m + std::max( 0, coord[ i ] - (dims_[ i ] - r) );
+          extent[ i ] = m + (coord[ i ] >= dims_[ i ] - r ? 1 : 0);
+          origin[ i ] = interior.origin( i ) + first;
+          offset[ i ] = interior.offset( i ) + first;
+        }
+        boxes_.push_back( Box( origin, extent, offset, interior.supersize(), interior.meshsize(), interior.shift() ) );
+
+        // next box (first direction running fastest)
+        for( int i = 0; i < dim; ++i )
+        {
+          if( ++coord[ i ] < dims_[ i ] )
+            break;
+          coord[ i ] = 0;
+        }
+      }
+    }
+
+    //! number of boxes
+    int size () const { return boxes_.size(); }
+
+    //! number of boxes in direction i
+    int dims ( int i ) const { return dims_[ i ]; }
+
+    //! box of thread t
+    const Box &box ( int t ) const
+    {
+      assert( (t >= 0) && (t < size()) );
+      return boxes_[ t ];
+    }
+
+  private:
+    iTupel dims_;
+    std::vector< Box > boxes_;
+  };
+
+}  // namespace Dune
+
+#endif  // DUNE_GRID_YASPGRIDTHREADPARTITION_HH